@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <print>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+
+#include <parallel/thread_pool.hpp>
+#include <tracking/factory.hpp>
+#include <trace/trace.hpp>
+
+#include "runner.hpp"
+
+namespace fs = std::filesystem;
+
+// Runs a tracker over every sequence of a dataset split in one process,
+// one tracker per sequence on a thread pool
+int main(int argc, char **argv)
+{
+    argparse::ArgumentParser parser("mot-bench");
+    parser.add_description("Track all sequences of a dataset split in parallel");
+    parser.add_argument("-d", "--dataset").required().help("Path to dataset (e.g. data/MOT20)");
+    parser.add_argument("-s", "--split").default_value(std::string("train")).help("Dataset split");
+    parser.add_argument("-c", "--config").required().help("Path to tracker config.toml");
+    parser.add_argument("-o", "--output").default_value(std::string("runs/bench")).help("Path to results folder");
+    parser.add_argument("-j", "--threads").default_value(0).scan<'i', int>().help("Sequences tracked in parallel, 0 uses all cores");
+    parser.add_argument("--gt").flag().help("Use ground-truth detections");
+    parser.add_argument("--trace").help("Write a Chrome trace of the run (open in ui.perfetto.dev), one track per pool thread");
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "{}", e.what());
+        std::cerr << parser;
+        return 1;
+    }
+
+    fs::path splitPath = fs::path(parser.get("--dataset")) / parser.get("--split");
+    if (!fs::is_directory(splitPath))
+    {
+        std::println(std::cerr, "Split directory not found: {}", splitPath.string());
+        return 1;
+    }
+
+    // Config is read once and every tracker is built from the same string
+    std::ifstream configFile(parser.get("--config"));
+    if (!configFile.is_open())
+    {
+        std::println(std::cerr, "Could not open config file: {}", parser.get("--config"));
+        return 1;
+    }
+    std::stringstream config;
+    config << configFile.rdbuf();
+    std::string toml = config.str();
+
+    fs::path outputDir(parser.get("--output"));
+    fs::create_directories(outputDir);
+
+    // Largest sequences first, so the tail of the run stays parallel
+    auto sequences = listSequences(splitPath);
+    std::vector<uintmax_t> sizes(sequences.size());
+    bool gt = parser.get<bool>("--gt");
+    for (size_t i = 0; i < sequences.size(); ++i)
+    {
+        std::error_code error;
+        sizes[i] = fs::file_size(sequences[i] / (gt ? "gt/gt.txt" : "det/det.txt"), error);
+    }
+    std::vector<size_t> order(sequences.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                     { return sizes[a] > sizes[b]; });
+
+    auto tracePath = parser.present("--trace");
+    if (tracePath)
+    {
+        trace::setThreadName("main");
+        trace::start();
+    }
+
+    int threads = parser.get<int>("--threads");
+    ThreadPool pool(threads > 0 ? static_cast<size_t>(threads) : std::thread::hardware_concurrency());
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<SequenceResult>> futures(sequences.size());
+    for (size_t i : order)
+    {
+        futures[i] = pool.submit([&, seqPath = sequences[i]]()
+                                 {
+            SequenceData sequence = loadSequence(seqPath, gt);
+            auto tracker = TrackerFactory::createFromString(toml);
+            ResultWriter out(outputDir / (sequence.name + ".txt"));
+            return runSequence(sequence, *tracker, &out); });
+    }
+
+    // Summary, in sequence order
+    std::vector<SequenceResult> results;
+    int status = 0;
+    for (size_t i = 0; i < futures.size(); ++i)
+    {
+        try
+        {
+            results.push_back(futures[i].get());
+        }
+        catch (const std::exception &e)
+        {
+            std::println(std::cerr, "{}: {}", sequences[i].filename().string(), e.what());
+            status = 1;
+        }
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ofstream csv(outputDir / "summary.csv");
+    csv << "sequence,frames,detections,load_ms,track_ms,ms_per_frame,fps\n";
+
+    std::println("{:<16} {:>7} {:>11} {:>9} {:>10} {:>9} {:>9}", "Sequence", "Frames", "Detections", "Load ms", "Track ms", "ms/frame", "FPS");
+    int totalFrames = 0;
+    size_t totalDetections = 0;
+    double totalTrackMs = 0.;
+    for (const auto &result : results)
+    {
+        double msPerFrame = result.frames > 0 ? result.track_ms / result.frames : 0.;
+        double fps = result.track_ms > 0. ? 1000. * result.frames / result.track_ms : 0.;
+        std::println("{:<16} {:>7} {:>11} {:>9.1f} {:>10.1f} {:>9.3f} {:>9.1f}",
+                     result.name, result.frames, result.detections, result.load_ms, result.track_ms, msPerFrame, fps);
+        csv << std::format("{},{},{},{:.3f},{:.3f},{:.4f},{:.2f}\n",
+                           result.name, result.frames, result.detections, result.load_ms, result.track_ms, msPerFrame, fps);
+
+        totalFrames += result.frames;
+        totalDetections += result.detections;
+        totalTrackMs += result.track_ms;
+    }
+
+    std::println("{:<16} {:>7} {:>11} {:>9} {:>10.1f} {:>9.3f} {:>9.1f}", "Total", totalFrames, totalDetections, "",
+                 totalTrackMs, totalFrames > 0 ? totalTrackMs / totalFrames : 0., totalTrackMs > 0. ? 1000. * totalFrames / totalTrackMs : 0.);
+    std::println("{} sequences on {} threads in {:.2f} s wall time", results.size(), pool.size(), wallSeconds);
+
+    if (tracePath)
+    {
+        trace::stop();
+        try
+        {
+            trace::write(*tracePath);
+        }
+        catch (const std::exception &e)
+        {
+            std::println(std::cerr, "{}", e.what());
+            status = 1;
+        }
+    }
+
+    return status;
+}
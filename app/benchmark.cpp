@@ -0,0 +1,150 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <print>
+#include <thread>
+
+#include <unistd.h>
+
+#include <trace/trace.hpp>
+
+#include "utility.hpp"
+
+namespace
+{
+    struct RunResult
+    {
+        double seconds = 0.;
+        std::vector<double> latencies_ms{};
+    };
+
+    RunResult runOnce(const std::vector<std::vector<Detection>> &frames, BaseTracker &tracker)
+    {
+        // Copied up front: update() assigns track ids in place
+        auto detections = frames;
+
+        RunResult result;
+        result.latencies_ms.reserve(detections.size());
+        for (auto &frame : detections)
+        {
+            auto start = std::chrono::steady_clock::now();
+            tracker.update(frame);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            result.seconds += std::chrono::duration<double>(elapsed).count();
+            result.latencies_ms.push_back(std::chrono::duration<double, std::milli>(elapsed).count());
+        }
+        return result;
+    }
+
+    std::string hostName()
+    {
+        char name[256] = {};
+        if (gethostname(name, sizeof(name) - 1) != 0)
+            return "";
+        return name;
+    }
+}
+
+int runBenchmark(const std::vector<std::vector<Detection>> &frames,
+                 const std::function<std::unique_ptr<BaseTracker>()> &create,
+                 const BenchmarkOptions &options,
+                 const std::string &json_path)
+{
+    if (options.repeat == 0)
+    {
+        std::println(std::cerr, "Error: --repeat must be at least 1");
+        return 1;
+    }
+
+    size_t numDetections = 0;
+    for (const auto &frame : frames)
+        numDetections += frame.size();
+
+    std::vector<RunResult> runs;
+    for (size_t run = 0; run < options.warmup + options.repeat; ++run)
+    {
+        auto tracker = create();
+        if (!tracker)
+        {
+            std::println(std::cerr, "Failed to create tracker");
+            return 1;
+        }
+
+        trace::Scope scope(run < options.warmup ? "warmup run" : "benchmark run", "app");
+        auto result = runOnce(frames, *tracker);
+        if (run >= options.warmup)
+            runs.push_back(std::move(result));
+    }
+
+    std::vector<double> latencies;
+    double seconds = 0.;
+    for (const auto &run : runs)
+    {
+        latencies.insert(latencies.end(), run.latencies_ms.begin(), run.latencies_ms.end());
+        seconds += run.seconds;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    double fps = seconds > 0. ? static_cast<double>(latencies.size()) / seconds : 0.;
+    double mean = latencies.empty() ? 0. : std::accumulate(latencies.begin(), latencies.end(), 0.) / static_cast<double>(latencies.size());
+    double min = latencies.empty() ? 0. : latencies.front();
+    double max = latencies.empty() ? 0. : latencies.back();
+    double p50 = percentile(latencies, 0.5);
+    double p99 = percentile(latencies, 0.99);
+
+    std::println(std::cerr, "{}: {} frames, {} detections, {} runs after {} warmup",
+                 options.sequence, frames.size(), numDetections, options.repeat, options.warmup);
+    std::println(std::cerr, "{}: {:.1f} FPS, latency mean {:.3f} ms, min {:.3f} ms, p50 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+                 options.sequence, fps, mean, min, p50, p99, max);
+
+    std::string runsJson;
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        double runFps = runs[i].seconds > 0. ? static_cast<double>(frames.size()) / runs[i].seconds : 0.;
+        runsJson += std::format("{}{{\"seconds\":{:.6f},\"fps\":{:.3f}}}", i ? "," : "", runs[i].seconds, runFps);
+    }
+
+#ifdef NDEBUG
+    constexpr bool optimized = true;
+#else
+    constexpr bool optimized = false;
+#endif
+#ifdef MOT_NO_PROFILING
+    constexpr bool profiling = false;
+#else
+    constexpr bool profiling = true;
+#endif
+
+    std::string json = std::format(
+        "{{\"sequence\":\"{}\",\"config\":\"{}\",\"frames\":{},\"detections\":{},\"warmup\":{},\"repeat\":{},\n"
+        " \"build\":{{\"compiler\":\"{}\",\"ndebug\":{},\"profiling\":{}}},\n"
+        " \"machine\":{{\"host\":\"{}\",\"threads\":{}}},\n"
+        " \"fps\":{:.3f},\n"
+        " \"latency_ms\":{{\"mean\":{:.6f},\"min\":{:.6f},\"p50\":{:.6f},\"p99\":{:.6f},\"max\":{:.6f}}},\n"
+        " \"runs\":[{}]}}\n",
+        trace::escape(options.sequence), trace::escape(options.config), frames.size(), numDetections, options.warmup, options.repeat,
+        trace::escape(__VERSION__), optimized, profiling,
+        trace::escape(hostName()), std::thread::hardware_concurrency(),
+        fps, mean, min, p50, p99, max, runsJson);
+
+    if (json_path.empty())
+    {
+        std::cout << json << std::flush;
+        return 0;
+    }
+
+    std::ofstream file(json_path);
+    file << json;
+    if (!file)
+    {
+        std::println(std::cerr, "Could not write {}", json_path);
+        return 1;
+    }
+    std::println(std::cerr, "Benchmark results written to {}", json_path);
+    return 0;
+}
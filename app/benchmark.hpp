@@ -0,0 +1,24 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <tracking/tracker.hpp>
+
+struct BenchmarkOptions
+{
+    std::string sequence;
+    std::string config;
+    size_t warmup = 1; // runs discarded before measuring
+    size_t repeat = 5; // measured runs
+};
+
+// Benchmark mode: every run tracks the preloaded frames with a fresh tracker from `create`,
+// timing update() alone. Reports per-frame latency over all measured runs and the overall FPS
+// on stderr, and as JSON to `json_path` (stdout when empty).
+int runBenchmark(const std::vector<std::vector<Detection>> &frames,
+                 const std::function<std::unique_ptr<BaseTracker>()> &create,
+                 const BenchmarkOptions &options,
+                 const std::string &json_path);
@@ -0,0 +1,98 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <print>
+#include <string>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+
+#include <io/binary_detections.hpp>
+#include <io/detection_file.hpp>
+#include <io/npy.hpp>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char **argv)
+{
+    argparse::ArgumentParser parser("mot-convert");
+    parser.add_description("Convert MOT detection files between text (.txt) and binary (.motb)");
+    parser.add_argument("-i", "--input").required().help("Input det.txt / gt.txt or .motb file");
+    parser.add_argument("-o", "--output").required().help("Output file, the format is the opposite of the input one");
+    parser.add_argument("-f", "--features").help("Embeddings (.npy, float32, one row per det.txt line) stored with text to binary");
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "{}", e.what());
+        std::cerr << parser;
+        return 1;
+    }
+
+    fs::path inPath(parser.get("--input"));
+    fs::path outPath(parser.get("--output"));
+
+    try
+    {
+        if (inPath.extension() == ".motb")
+        {
+            // Binary to text
+            BinaryDetectionFile inFile(inPath);
+            std::ofstream outFile(outPath);
+            if (!outFile.is_open())
+            {
+                std::println(std::cerr, "Could not open output file: {}", outPath.string());
+                return 1;
+            }
+
+            std::vector<Detection> detections;
+            for (int frameId = inFile.getFirstFrame(); frameId <= inFile.getLastFrame(); ++frameId)
+            {
+                inFile.readFrame(frameId, detections);
+                for (const auto &det : detections)
+                    outFile << det << "\n";
+            }
+            std::println(std::cerr, "{}: {} detections written", outPath.string(), inFile.size());
+        }
+        else
+        {
+            // Text to binary
+            DetectionFile inFile(inPath);
+            auto featuresPath = parser.present<std::string>("--features");
+            if (!featuresPath)
+            {
+                writeBinaryDetections(outPath, inFile.getDetections());
+            }
+            else
+            {
+                // Embeddings follow the file line order, detections are grouped by frame
+                NpyArray embeddings(*featuresPath);
+                if (embeddings.rows() != inFile.size())
+                {
+                    std::println(std::cerr, "{} has {} rows, expected {}", *featuresPath, embeddings.rows(), inFile.size());
+                    return 1;
+                }
+
+                std::vector<float> features;
+                features.reserve(inFile.size() * embeddings.cols());
+                for (size_t row : inFile.getRows())
+                {
+                    auto feature = embeddings.row(row);
+                    features.insert(features.end(), feature.begin(), feature.end());
+                }
+                writeBinaryDetections(outPath, inFile.getDetections(), features, embeddings.cols());
+            }
+            std::println(std::cerr, "{}: {} detections written", outPath.string(), inFile.size());
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "Conversion failed: {}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
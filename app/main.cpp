@@ -1,80 +1,123 @@
+#include <chrono>
+#include <atomic>
 #include <filesystem>
-#include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <print>
-#include <sstream>
 #include <string>
+#include <thread>
+
+#include <unistd.h>
 
 #include <argparse/argparse.hpp>
 #include <opencv2/opencv.hpp>
 #include <types/frame.hpp>
 #include <utils/draw_utils.hpp>
 
+#include <io/binary_detections.hpp>
+#include <io/detection_file.hpp>
+#include <io/frame_source.hpp>
+#include <io/npy.hpp>
+#include <io/result_writer.hpp>
+#include <io/sequence.hpp>
+#include <parallel/spsc_queue.hpp>
 #include <tracking/factory.hpp>
+#include <tracking/profiler.hpp>
+#include <tracking/recorder.hpp>
+#include <trace/trace.hpp>
 
-namespace fs = std::filesystem;
+#include "benchmark.hpp"
+#include "stream.hpp"
 
-struct SequenceInfo
-{
-    std::string imDir;
-    double frameRate{};
-    int imWidth{};
-    int imHeight{};
-};
+namespace fs = std::filesystem;
 
-SequenceInfo parseSequenceInfo(const fs::path &iniPath)
+static void printProfile(const std::string &seqName, const TrackerProfiler &profiler)
 {
-    std::ifstream file(iniPath);
-    if (!file)
+    std::string counters = profiler.hasCounters() ? std::format(" {:>6} {:>10} {:>10}", "IPC", "LLC miss", "br miss") : "";
+    std::println(std::cerr, "{}: {:<8} {:>7} {:>9} {:>9} {:>9} {:>9} {:>11} {:>9}{}",
+                 seqName, "stage", "calls", "mean us", "p50 us", "p99 us", "max us", "mean cells", "max dim", counters);
+    for (size_t i = 0; i < NUM_TRACKER_STAGES; ++i)
     {
-        std::println(std::cerr, "INI file not found: {}", iniPath.string());
-        return {};
+        auto stage = static_cast<TrackerStage>(i);
+        auto stats = profiler.getStats(stage);
+        std::string cells = stats.matrices ? std::format("{:.0f}", stats.mean_cells) : "-";
+        std::string dim = stats.matrices ? std::format("{}x{}", stats.max_rows, stats.max_cols) : "-";
+        std::string counters = stats.has_counters ? std::format(" {:>6.2f} {:>10.0f} {:>10.0f}", stats.ipc(), stats.cache_misses, stats.branch_misses) : "";
+        std::println(std::cerr, "{}: {:<8} {:>7} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f} {:>11} {:>9}{}",
+                     seqName, stageName(stage), stats.count, stats.mean_us, stats.p50_us, stats.p99_us, stats.max_us, cells, dim, counters);
     }
+    if (!profiler.hasCounters())
+        std::println(std::cerr, "{}: no hardware counters ({})", seqName, profiler.getCounterError());
 
-    SequenceInfo info;
-    std::string line;
-    while (std::getline(file, line))
-    {
-        if (line.empty() || line[0] == '[' || line[0] == ';')
-            continue;
+    auto counts = profiler.getTrackCounts();
+    std::println(std::cerr, "{}: tracks at the last frame: {} tracked, {} lost, {} unconfirmed (at most {} tracks)",
+                 seqName, counts.tracked, counts.lost, counts.unconfirmed, counts.max_total);
+}
 
-        auto eq = line.find('=');
-        if (eq == std::string::npos)
-            continue;
+static void printMemory(const std::string &seqName, const MemoryReport &report)
+{
+    auto kib = [](size_t bytes)
+    { return static_cast<double>(bytes) / 1024.; };
+    std::println(std::cerr, "{}: tracker state {:.1f} KiB for {} tracks: tracks {:.1f}, filters {:.1f}, history {:.1f}, features {:.1f}, scratch {:.1f}",
+                 seqName, kib(report.total()), report.num_tracks, kib(report.tracks), kib(report.filters),
+                 kib(report.history), kib(report.features), kib(report.scratch));
+}
 
-        std::string key = line.substr(0, eq);
-        std::string val = line.substr(eq + 1);
+// Wraps the tracker into a recorder with --record, null when the recording cannot be opened
+static std::unique_ptr<BaseTracker> recordUpdates(std::unique_ptr<BaseTracker> tracker, const std::optional<std::string> &path)
+{
+    if (!path)
+        return tracker;
+    try
+    {
+        return std::make_unique<RecordingTracker>(std::move(tracker), *path);
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "Could not record updates: {}", e.what());
+        return nullptr;
+    }
+}
 
-        auto trim = [](std::string &s)
-        {
-            s.erase(0, s.find_first_not_of(" \t\r\n"));
-            s.erase(s.find_last_not_of(" \t\r\n") + 1);
-        };
-        trim(key);
-        trim(val);
-
-        if (key == "imDir")
-            info.imDir = val;
-        else if (key == "frameRate")
-            info.frameRate = std::stod(val);
-        else if (key == "imWidth")
-            info.imWidth = std::stoi(val);
-        else if (key == "imHeight")
-            info.imHeight = std::stoi(val);
-    }
-    return info;
+static void writeTrace(const std::string &path)
+{
+    trace::stop();
+    try
+    {
+        trace::write(path);
+        std::println(std::cerr, "Trace of {} events written to {} ({} dropped)", trace::size(), path, trace::dropped());
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "{}", e.what());
+    }
 }
 
 int main(int argc, char **argv)
 {
     argparse::ArgumentParser parser("mot");
     parser.add_description("Multi Object Tracker");
-    parser.add_argument("-i", "--input").required().help("Path to MOT sequence folder");
+    parser.add_argument("-i", "--input").help("Path to MOT sequence folder");
     parser.add_argument("-c", "--config").required().help("Path to tracker config.toml");
+    parser.add_argument("--stream").help("Read detections from stdin, unix:<socket path> or shm:<ring name> instead of --input");
     parser.add_argument("-o", "--output").help("Path to results folder (if not provided, output to stdout)");
     parser.add_argument("--gt").flag().help("Use ground-truth detections");
+    parser.add_argument("-f", "--features").help("Embeddings (.npy, float32, one row per detection file line) for appearance matching");
+    parser.add_argument("--binary").flag().help("Read detections from the .motb file next to det.txt / gt.txt (see mot-convert)");
     parser.add_argument("-d", "--display").flag().help("Display images");
     parser.add_argument("-s", "--save").flag().help("Save video into output folder");
+    parser.add_argument("--video").help("Draw on a video file or camera index instead of the sequence images");
+    parser.add_argument("--prefetch").default_value(8).scan<'i', int>().help("Frames decoded ahead of the tracker when visualizing");
+    parser.add_argument("--decode-threads").default_value(2).scan<'i', int>().help("Image decoding threads when visualizing");
+    parser.add_argument("--trajectories").flag().help("Also write binary trajectories (.mott) into output folder");
+    parser.add_argument("--trace").help("Write a Chrome trace of tracker, I/O and thread-pool events (open in ui.perfetto.dev)");
+    parser.add_argument("--record").help("Record every tracker update (detections, embeddings, ids) into a .motr file for mot-replay");
+    parser.add_argument("--benchmark").flag().help("Time the tracker alone over preloaded detections, results as JSON in output folder (or stdout)");
+    parser.add_argument("--warmup").default_value(1).scan<'i', int>().help("Unmeasured runs before --benchmark runs");
+    parser.add_argument("--repeat").default_value(5).scan<'i', int>().help("Measured --benchmark runs, each with a fresh tracker");
+    parser.add_argument("--profile").flag().help("Report per-stage tracker latencies, matrix sizes, track counts, tracker memory and hardware counters (Linux)");
 
     try
     {
@@ -87,29 +130,177 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    // Tracing covers the whole run, streaming included
+    auto tracePath = parser.present<std::string>("--trace");
+    if (tracePath)
+    {
+        trace::setThreadName("main");
+        trace::start();
+    }
+
+    // Streaming input
+    if (auto stream = parser.present<std::string>("--stream"))
+    {
+        auto tracker = TrackerFactory::create(parser.get("--config"));
+        if (!tracker)
+        {
+            std::println(std::cerr, "Failed to create tracker");
+            return 1;
+        }
+        tracker = recordUpdates(std::move(tracker), parser.present<std::string>("--record"));
+        if (!tracker)
+            return 1;
+        int status = runStream(*stream, *tracker);
+        if (tracePath)
+            writeTrace(*tracePath);
+        return status;
+    }
+
+    if (!parser.present<std::string>("--input"))
+    {
+        std::println(std::cerr, "Either --input or --stream is required");
+        std::cerr << parser;
+        return 1;
+    }
+
     // Input
     fs::path seqPath(parser.get("--input"));
     std::string seqName = seqPath.stem().string();
+    if (!fs::exists(seqPath / "seqinfo.ini"))
+        std::println(std::cerr, "INI file not found: {}", (seqPath / "seqinfo.ini").string());
     auto seqInfo = parseSequenceInfo(seqPath / "seqinfo.ini");
 
     bool gt = parser.get<bool>("--gt");
-    fs::path inPath = seqPath / (gt ? "gt/gt.txt" : "det/det.txt");
+    bool binary = parser.get<bool>("--binary");
+    fs::path inPath = seqPath / (gt ? "gt/gt" : "det/det");
+    inPath += binary ? ".motb" : ".txt";
 
-    std::ifstream inFile(inPath);
-    if (!inFile.is_open())
+    auto featuresPath = parser.present<std::string>("--features");
+    if (featuresPath && binary)
     {
-        std::println(std::cerr, "Could not open input file: {}", inPath.string());
+        std::println(std::cerr, "Error: --features applies to text detections, store them in the .motb with mot-convert");
         return 1;
     }
 
-    bool display = parser.get<bool>("--display");
-    fs::path imgPath = seqPath / seqInfo.imDir;
-    if (display && !fs::is_directory(imgPath))
+    // Both readers fill the reusable per-frame buffer
+    std::unique_ptr<DetectionFile> textFile;
+    std::unique_ptr<BinaryDetectionFile> binaryFile;
+    std::unique_ptr<NpyArray> embeddings;
+    std::function<void(int, std::vector<Detection> &)> readFrame;
+    int lastFrame = 0;
+    try
     {
-        std::println(std::cerr, "Image directory does not exist: {}", imgPath.string());
+        if (binary)
+        {
+            binaryFile = std::make_unique<BinaryDetectionFile>(inPath);
+            lastFrame = binaryFile->getLastFrame();
+            readFrame = [&](int frameId, std::vector<Detection> &detections)
+            { binaryFile->readFrame(frameId, detections); };
+        }
+        else
+        {
+            textFile = std::make_unique<DetectionFile>(inPath);
+            lastFrame = textFile->getLastFrame();
+
+            if (featuresPath)
+            {
+                embeddings = std::make_unique<NpyArray>(*featuresPath);
+                if (embeddings->rows() != textFile->size())
+                {
+                    std::println(std::cerr, "{} has {} rows, expected one per detection ({})",
+                                 *featuresPath, embeddings->rows(), textFile->size());
+                    return 1;
+                }
+            }
+
+            // Embeddings are copied from the mapping into the buffer's feature vectors,
+            // which keep their capacity from frame to frame
+            readFrame = [&](int frameId, std::vector<Detection> &detections)
+            {
+                auto frameDetections = textFile->getFrame(frameId);
+                detections.assign(frameDetections.begin(), frameDetections.end());
+                if (!embeddings)
+                    return;
+
+                auto frameRows = textFile->getFrameRows(frameId);
+                for (size_t i = 0; i < detections.size(); ++i)
+                {
+                    auto feature = embeddings->row(frameRows[i]);
+                    detections[i].features.assign(feature.begin(), feature.end());
+                }
+            };
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "Could not read input file: {}", e.what());
         return 1;
     }
 
+    bool display = parser.get<bool>("--display");
+    bool saveVideo = parser.get<bool>("--save");
+    bool visualize = display || saveVideo;
+
+    // Benchmark: every frame is read before tracking starts, nothing is written meanwhile
+    if (parser.get<bool>("--benchmark"))
+    {
+        if (visualize)
+        {
+            std::println(std::cerr, "Error: --benchmark does not display or save images");
+            return 1;
+        }
+
+        int numFrames = seqInfo.seqLength > 0 ? seqInfo.seqLength : lastFrame;
+        std::vector<std::vector<Detection>> preloaded(static_cast<size_t>(std::max(0, numFrames)));
+        for (int frameId = 1; frameId <= numFrames; ++frameId)
+            readFrame(frameId, preloaded[static_cast<size_t>(frameId - 1)]);
+
+        BenchmarkOptions options;
+        options.sequence = seqName;
+        options.config = parser.get("--config");
+        options.warmup = static_cast<size_t>(std::max(0, parser.get<int>("--warmup")));
+        options.repeat = static_cast<size_t>(std::max(0, parser.get<int>("--repeat")));
+
+        std::string jsonPath;
+        if (auto outputDir = parser.present<std::string>("--output"))
+        {
+            fs::create_directories(*outputDir);
+            jsonPath = (fs::path(*outputDir) / (seqName + ".benchmark.json")).string();
+        }
+
+        int status = runBenchmark(preloaded, [&]()
+                                  { return TrackerFactory::create(options.config); }, options, jsonPath);
+        if (tracePath)
+            writeTrace(*tracePath);
+        return status;
+    }
+
+    // Images are only decoded when something is displayed or saved, on background threads
+    int prefetch = std::max(1, parser.get<int>("--prefetch"));
+    std::unique_ptr<FrameSource> frames = std::make_unique<NullSource>();
+    if (visualize)
+    {
+        try
+        {
+            auto video = parser.present<std::string>("--video");
+            std::unique_ptr<FrameSource> source = video ? openFrameSource(*video)
+                                                        : std::make_unique<ImageFolderSource>(seqPath / seqInfo.imDir, seqInfo.frameRate);
+            frames = std::make_unique<ThreadedFrameSource>(std::move(source), static_cast<size_t>(prefetch),
+                                                           static_cast<size_t>(std::max(1, parser.get<int>("--decode-threads"))));
+        }
+        catch (const std::exception &e)
+        {
+            std::println(std::cerr, "{}", e.what());
+            return 1;
+        }
+    }
+
+    // Sequence properties from seqinfo.ini, otherwise from the frames
+    double frameRate = seqInfo.frameRate > 0. ? seqInfo.frameRate : frames->getFrameRate();
+    if (frameRate <= 0.)
+        frameRate = 25.;
+    cv::Size imageSize = seqInfo.imWidth > 0 ? cv::Size(seqInfo.imWidth, seqInfo.imHeight) : frames->getFrameSize();
+
     // Config
     auto tracker = TrackerFactory::create(parser.get("--config"));
     if (!tracker)
@@ -118,28 +309,51 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    std::shared_ptr<TrackerProfiler> profiler = nullptr;
+    if (parser.get<bool>("--profile"))
+    {
+        profiler = std::make_shared<TrackerProfiler>();
+        profiler->enableCounters();
+        tracker->setProfiler(profiler);
+    }
+
+    tracker = recordUpdates(std::move(tracker), parser.present<std::string>("--record"));
+    if (!tracker)
+        return 1;
+
     // Output
     auto outputDir = parser.present<std::string>("--output");
-    std::ofstream outFile;
-    std::ostream &out = [&]() -> std::ostream &
+    bool trajectories = parser.get<bool>("--trajectories");
+    if (trajectories && !outputDir)
+    {
+        std::println(std::cerr, "Error: --trajectories requires --output to be specified");
+        return 1;
+    }
+
+    // Files are written by a background thread, stdout inline
+    std::unique_ptr<ResultWriter> out;
+    std::unique_ptr<ResultWriter> trajectoryOut;
+    try
     {
         if (outputDir)
         {
-            fs::path outPath = fs::path(*outputDir) / (seqName + ".txt");
-            fs::create_directories(outPath.parent_path());
-            outFile.open(outPath);
-            if (!outFile.is_open())
-            {
-                std::println(std::cerr, "Could not open output file: {}", outPath.string());
-                exit(1);
-            }
-            return outFile;
+            fs::create_directories(*outputDir);
+            out = std::make_unique<ResultWriter>(fs::path(*outputDir) / (seqName + ".txt"), ResultFormat::Text, true);
+            if (trajectories)
+                trajectoryOut = std::make_unique<ResultWriter>(fs::path(*outputDir) / (seqName + ".mott"), ResultFormat::Binary, true);
         }
-        return std::cout;
-    }();
+        else
+        {
+            out = std::make_unique<ResultWriter>(STDOUT_FILENO);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "Could not open output file: {}", e.what());
+        return 1;
+    }
 
     // Video writer
-    bool saveVideo = parser.get<bool>("--save");
     if (saveVideo && !outputDir)
     {
         std::println(std::cerr, "Error: --save requires --output to be specified");
@@ -147,11 +361,10 @@ int main(int argc, char **argv)
     }
 
     cv::VideoWriter videoWriter;
-    cv::Size imageSize(seqInfo.imWidth, seqInfo.imHeight);
     if (saveVideo)
     {
         fs::path savePath = fs::path(*outputDir) / (seqName + ".mp4");
-        videoWriter.open(savePath.string(), cv::VideoWriter::fourcc('m', 'p', '4', 'v'), seqInfo.frameRate, imageSize, true);
+        videoWriter.open(savePath.string(), cv::VideoWriter::fourcc('m', 'p', '4', 'v'), frameRate, imageSize, true);
 
         if (!videoWriter.isOpened())
         {
@@ -161,75 +374,151 @@ int main(int argc, char **argv)
     }
 
     // Main
-    std::istringstream iss;
-    std::string line;
-    std::string next_line;
+    // Frame count from seqinfo.ini, otherwise from the frames or the detections themselves
+    int numFrames = seqInfo.seqLength > 0 ? seqInfo.seqLength : frames->getFrameCount();
+    if (numFrames == 0)
+        numFrames = lastFrame;
+
+    // Visualization pipeline: frames are decoded ahead by the frame source while the main thread
+    // tracks, results are drawn, encoded and shown on a render thread. The bounded queue between
+    // the tracker and the renderer also bounds the number of frames in flight, and rendered
+    // images go back to the main thread to be decoded into again.
+    struct RenderItem
+    {
+        int frameId = 0; // 0 ends the stream
+        cv::Mat image;
+        std::vector<Detection> detections;
+    };
+
+    std::unique_ptr<SpscQueue<RenderItem>> renderQueue;
+    std::unique_ptr<SpscQueue<cv::Mat>> recycleQueue;
+    std::atomic<bool> stopRequested{false};
+    std::thread renderThread;
 
-    Detection detection;
+    if (visualize)
+    {
+        renderQueue = std::make_unique<SpscQueue<RenderItem>>(static_cast<size_t>(prefetch));
+        recycleQueue = std::make_unique<SpscQueue<cv::Mat>>(static_cast<size_t>(prefetch) * 2);
+        renderThread = std::thread([&]()
+                                   {
+            trace::setThreadName("render");
+            while (true)
+            {
+                RenderItem item = renderQueue->pop();
+                if (item.frameId == 0)
+                    break;
+
+                // Keep draining after ESC so the tracker never blocks on a full queue
+                if (stopRequested.load(std::memory_order_relaxed))
+                    continue;
+
+                trace::Scope scope("render", "app");
+                Frame frame(item.image);
+                cv::Mat output = drawDetections(frame, item.detections, true, true);
+
+                if (saveVideo)
+                    videoWriter.write(output);
+
+                if (display)
+                {
+                    cv::imshow("Multi Object Tracking", output);
+                    if (cv::waitKey(static_cast<int>(1000.0 / frameRate)) == 27)
+                        stopRequested = true;
+                }
+
+                // Hand the buffer back, dropped if the tracker has enough spare ones
+                recycleQueue->tryPush(item.image);
+            }
 
-    std::vector<fs::path> imageFiles;
-    for (const auto &entry : fs::directory_iterator(imgPath))
-        imageFiles.push_back(entry.path());
-    std::sort(imageFiles.begin(), imageFiles.end());
+            if (display)
+                cv::destroyAllWindows(); });
+    }
 
     std::vector<Detection> detections;
+    std::chrono::steady_clock::duration trackingTime{};
+    int processedFrames = 0;
+    auto pipelineStart = std::chrono::steady_clock::now();
 
-    for (const auto &path : imageFiles)
+    // Decoding, tracking and writing may throw: stop the render thread before reporting it
+    try
     {
-        Frame frame(cv::imread(path.string()));
-        detections.clear();
-
-        // Read detections from file
-        while (true)
+        for (int frameId = 1; frameId <= numFrames && !stopRequested; ++frameId)
         {
-            if (!next_line.empty())
+            // Decoded ahead, swapped into a recycled buffer
+            cv::Mat image;
+            if (visualize)
             {
-                line = next_line;
-                next_line.clear();
+                if (auto recycled = recycleQueue->tryPop())
+                    image = std::move(*recycled);
+                if (!frames->read(image))
+                    break;
             }
-            else if (!std::getline(inFile, line))
-            {
-                break;
-            }
-            iss.clear();
-            iss.str(line);
-            iss >> detection;
 
-            if (detection.frame_id == frame.getId())
-                detections.push_back(detection);
-            else
+            // Detections of the frame, the buffer is reused across frames
             {
-                next_line = line;
-                break;
+                trace::Scope scope("read detections", "io");
+                readFrame(frameId, detections);
             }
-        }
-
-        // Process detections
-        tracker->update(detections);
-        for (const auto &det : detections)
-            out << det << "\n";
 
-        // Visualize results
-        cv::Mat output = drawDetections(frame, detections, true, true);
+            // Process detections
+            auto start = std::chrono::steady_clock::now();
+            tracker->update(detections);
+            trackingTime += std::chrono::steady_clock::now() - start;
+            processedFrames++;
 
-        if (saveVideo)
-            videoWriter.write(output);
+            out->write(detections);
+            if (trajectoryOut)
+                trajectoryOut->write(detections);
 
-        if (display)
+            if (visualize)
+                renderQueue->push(RenderItem{frameId, std::move(image), detections});
+        }
+    }
+    catch (const std::exception &e)
+    {
+        if (renderThread.joinable())
         {
-            cv::imshow("Multi Object Tracking", output);
-            if (cv::waitKey(static_cast<int>(1000.0 / seqInfo.frameRate)) == 27)
-                break;
+            renderQueue->push(RenderItem{});
+            renderThread.join();
         }
+        std::println(std::cerr, "{}: tracking failed: {}", seqName, e.what());
+        return 1;
+    }
+
+    if (visualize)
+    {
+        renderQueue->push(RenderItem{});
+        renderThread.join();
+
+        double pipelineSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - pipelineStart).count();
+        std::println(std::cerr, "{}: end-to-end {:.1f} FPS", seqName, pipelineSeconds > 0. ? processedFrames / pipelineSeconds : 0.);
+    }
+
+    double trackingSeconds = std::chrono::duration<double>(trackingTime).count();
+    std::println(std::cerr, "{}: {} frames, tracker {:.1f} FPS",
+                 seqName, processedFrames, trackingSeconds > 0. ? processedFrames / trackingSeconds : 0.);
+    if (profiler)
+    {
+        printProfile(seqName, *profiler);
+        printMemory(seqName, tracker->getMemoryReport());
     }
 
     if (videoWriter.isOpened())
         videoWriter.release();
 
-    if (outFile.is_open())
-        outFile.close();
-
-    cv::destroyAllWindows();
+    try
+    {
+        out->flush();
+        if (trajectoryOut)
+            trajectoryOut->flush();
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "Could not write results: {}", e.what());
+        return 1;
+    }
 
+    if (tracePath)
+        writeTrace(*tracePath);
     return 0;
 }
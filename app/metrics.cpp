@@ -0,0 +1,149 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <print>
+#include <string>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+
+#include <io/detection_file.hpp>
+#include <io/sequence.hpp>
+#include <metrics/mot_metrics.hpp>
+#include <parallel/thread_pool.hpp>
+
+namespace fs = std::filesystem;
+
+struct SequenceScore
+{
+    std::string name;
+    MotMetrics metrics;
+    std::string error;
+};
+
+static void printHeader()
+{
+    std::println("{:<16} {:>6} {:>6} {:>6} {:>6} {:>6} {:>6} {:>5} {:>5} {:>5} {:>7} {:>7} {:>6} {:>6} {:>6} {:>6} {:>6} {:>6} {:>6} {:>6}",
+                 "", "IDF1", "IDP", "IDR", "Rcll", "Prcn", "GT", "MT", "PT", "ML", "FP", "FN", "IDs", "FM",
+                 "MOTA", "MOTP", "HOTA", "DetA", "AssA", "LocA");
+}
+
+static void printRow(const std::string &name, const MotMetrics &m)
+{
+    std::println("{:<16} {:>5.1f}% {:>5.1f}% {:>5.1f}% {:>5.1f}% {:>5.1f}% {:>6} {:>5} {:>5} {:>5} {:>7} {:>7} {:>6} {:>6} {:>5.1f}% {:>6.3f} {:>5.1f}% {:>5.1f}% {:>5.1f}% {:>5.1f}%",
+                 name, 100. * m.idf1(), 100. * m.idp(), 100. * m.idr(), 100. * m.recall(), 100. * m.precision(),
+                 m.gt_tracks, m.mostly_tracked, m.partially_tracked, m.mostly_lost, m.false_positives, m.misses,
+                 m.switches, m.fragmentations, 100. * m.mota(), m.motp(),
+                 100. * m.hota(), 100. * m.deta(), 100. * m.assa(), 100. * m.loca());
+}
+
+static void writeRow(std::ofstream &csv, const std::string &name, const MotMetrics &m)
+{
+    csv << std::format("{},{:.6f},{:.6f},{:.6f},{:.6f},{:.6f},{},{},{},{},{},{},{},{},{:.6f},{:.6f},{:.6f},{:.6f},{:.6f},{:.6f}\n",
+                       name, m.idf1(), m.idp(), m.idr(), m.recall(), m.precision(),
+                       m.gt_tracks, m.mostly_tracked, m.partially_tracked, m.mostly_lost, m.false_positives, m.misses,
+                       m.switches, m.fragmentations, m.mota(), m.motp(), m.hota(), m.deta(), m.assa(), m.loca());
+}
+
+// Scores tracker outputs (<results>/<seq>.txt) against the ground truth of a dataset split
+int main(int argc, char **argv)
+{
+    argparse::ArgumentParser parser("mot-metrics");
+    parser.add_description("CLEAR-MOT, IDF1 and HOTA of tracker results");
+    parser.add_argument("-d", "--dataset").required().help("Path to dataset (e.g. data/MOT20)");
+    parser.add_argument("-s", "--split").default_value(std::string("train")).help("Dataset split");
+    parser.add_argument("-r", "--results").required().help("Folder of <seq-name>.txt tracker results");
+    parser.add_argument("-o", "--output").help("Write the metrics as CSV");
+    parser.add_argument("--iou").default_value(0.5f).scan<'g', float>().help("IoU threshold of CLEAR-MOT and IDF1 matches");
+    parser.add_argument("-j", "--threads").default_value(0).scan<'i', int>().help("Worker threads, 0 uses all cores");
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "{}", e.what());
+        std::cerr << parser;
+        return 1;
+    }
+
+    fs::path splitPath = fs::path(parser.get("--dataset")) / parser.get("--split");
+    fs::path resultsPath(parser.get("--results"));
+    if (!fs::is_directory(splitPath))
+    {
+        std::println(std::cerr, "Split directory not found: {}", splitPath.string());
+        return 1;
+    }
+
+    // Sequences with both ground truth and results
+    std::vector<fs::path> sequences;
+    for (const auto &seqPath : listSequences(splitPath))
+    {
+        if (!fs::exists(seqPath / "gt/gt.txt"))
+            continue;
+        if (!fs::exists(resultsPath / (seqPath.filename().string() + ".txt")))
+        {
+            std::println(std::cerr, "No results for {}, skipping", seqPath.filename().string());
+            continue;
+        }
+        sequences.push_back(seqPath);
+    }
+    if (sequences.empty())
+    {
+        std::println(std::cerr, "Nothing to evaluate in {}", splitPath.string());
+        return 1;
+    }
+
+    MetricsConfig config;
+    config.iou_threshold = parser.get<float>("--iou");
+
+    int threads = parser.get<int>("--threads");
+    ThreadPool pool(threads > 0 ? static_cast<size_t>(threads) : std::thread::hardware_concurrency());
+
+    // Sequences in parallel, HOTA thresholds of each sequence on the same pool
+    std::vector<SequenceScore> scores(sequences.size());
+    pool.parallelFor(0, sequences.size(), [&](size_t i)
+                     {
+        auto &score = scores[i];
+        score.name = sequences[i].filename().string();
+        try
+        {
+            DetectionFile gt(sequences[i] / "gt/gt.txt");
+            DetectionFile results(resultsPath / (score.name + ".txt"));
+            score.metrics = evaluateMot(gt.getDetections(), results.getDetections(), config, &pool);
+        }
+        catch (const std::exception &e)
+        {
+            score.error = e.what();
+        } });
+
+    std::ofstream csv;
+    if (auto output = parser.present("--output"))
+    {
+        csv.open(*output);
+        csv << "sequence,idf1,idp,idr,recall,precision,gt,mt,pt,ml,fp,fn,ids,fm,mota,motp,hota,deta,assa,loca\n";
+    }
+
+    int status = 0;
+    MotMetrics overall;
+    printHeader();
+    for (const auto &score : scores)
+    {
+        if (!score.error.empty())
+        {
+            std::println(std::cerr, "{}: {}", score.name, score.error);
+            status = 1;
+            continue;
+        }
+        printRow(score.name, score.metrics);
+        if (csv.is_open())
+            writeRow(csv, score.name, score.metrics);
+        overall += score.metrics;
+    }
+    printRow("OVERALL", overall);
+    if (csv.is_open())
+        writeRow(csv, "OVERALL", overall);
+
+    return status;
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <print>
+#include <string>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+
+#include <tracking/factory.hpp>
+#include <tracking/recorder.hpp>
+
+#include "utility.hpp"
+
+namespace
+{
+    void printLatency(const char *label, std::vector<double> latencies)
+    {
+        std::sort(latencies.begin(), latencies.end());
+        std::println(std::cerr, "{}: p50 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+                     label, percentile(latencies, 0.5), percentile(latencies, 0.99), percentile(latencies, 1.));
+    }
+}
+
+// Replays a recording made with mot --record through a fresh tracker: compares latencies
+// with the recorded ones and checks that the same track ids come out
+int main(int argc, char **argv)
+{
+    argparse::ArgumentParser parser("mot-replay");
+    parser.add_description("Replay recorded tracker updates and diff the track ids");
+    parser.add_argument("-r", "--recording").required().help("Recording written by mot --record (.motr)");
+    parser.add_argument("-c", "--config").required().help("Path to tracker config.toml");
+    parser.add_argument("--realtime").flag().help("Wait for the recorded timestamps instead of replaying back to back");
+    parser.add_argument("--spikes").default_value(5).scan<'i', int>().help("Slowest recorded updates to compare");
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "{}", e.what());
+        std::cerr << parser;
+        return 1;
+    }
+
+    auto tracker = TrackerFactory::create(parser.get("--config"));
+    if (!tracker)
+    {
+        std::println(std::cerr, "Failed to create tracker");
+        return 1;
+    }
+
+    ReplayOptions options;
+    options.realtime = parser.get<bool>("--realtime");
+
+    ReplayResult result;
+    try
+    {
+        result = replayRecording(parser.get("--recording"), *tracker, options);
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "Could not replay: {}", e.what());
+        return 1;
+    }
+
+    std::println(std::cerr, "{} updates, {} detections{}", result.updates, result.detections,
+                 result.truncated ? " (recording truncated after the last complete update)" : "");
+    printLatency("recorded", result.recorded_ms);
+    printLatency("replayed", result.replayed_ms);
+
+    // Where the recording was slowest, and whether the replay reproduces it
+    std::vector<size_t> order(result.updates);
+    std::iota(order.begin(), order.end(), 0);
+    size_t spikes = std::min(order.size(), static_cast<size_t>(std::max(0, parser.get<int>("--spikes"))));
+    std::partial_sort(order.begin(), order.begin() + static_cast<long>(spikes), order.end(), [&](size_t a, size_t b)
+                      { return result.recorded_ms[a] > result.recorded_ms[b]; });
+    for (size_t k = 0; k < spikes; ++k)
+    {
+        size_t i = order[k];
+        std::println(std::cerr, "update {}: recorded {:.3f} ms, replayed {:.3f} ms", i, result.recorded_ms[i], result.replayed_ms[i]);
+    }
+
+    if (!result.identical())
+    {
+        std::println(std::cerr, "Track ids differ: {} ids in {} updates, first at update {}",
+                     result.mismatched_ids, result.mismatched_updates, result.first_mismatch);
+        return 2;
+    }
+    std::println(std::cerr, "Track ids identical");
+    return 0;
+}
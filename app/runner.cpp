@@ -0,0 +1,76 @@
+#include "runner.hpp"
+
+#include <chrono>
+#include <stdexcept>
+
+#include <io/npy.hpp>
+#include <trace/trace.hpp>
+
+SequenceData loadSequence(const std::filesystem::path &seqPath, bool gt, const std::filesystem::path &features)
+{
+    trace::Scope scope("load sequence", "app");
+    auto start = std::chrono::steady_clock::now();
+
+    SequenceData sequence;
+    sequence.name = seqPath.filename().string();
+    sequence.info = parseSequenceInfo(seqPath / "seqinfo.ini");
+    sequence.detections = std::make_unique<DetectionFile>(seqPath / (gt ? "gt/gt.txt" : "det/det.txt"));
+
+    if (!features.empty())
+    {
+        NpyArray embeddings(seqPath / features);
+        if (embeddings.rows() != sequence.detections->size())
+            throw std::runtime_error((seqPath / features).string() + " has " + std::to_string(embeddings.rows()) +
+                                     " rows, expected one per detection");
+
+        for (int frameId = sequence.detections->getFirstFrame(); frameId <= sequence.detections->getLastFrame(); ++frameId)
+        {
+            auto frameDetections = sequence.detections->getFrame(frameId);
+            auto frameRows = sequence.detections->getFrameRows(frameId);
+            for (size_t i = 0; i < frameDetections.size(); ++i)
+            {
+                auto feature = embeddings.row(frameRows[i]);
+                frameDetections[i].features.assign(feature.begin(), feature.end());
+            }
+        }
+    }
+
+    sequence.load_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return sequence;
+}
+
+SequenceResult runSequence(const SequenceData &sequence, BaseTracker &tracker, ResultWriter *out, bool keep_tracks)
+{
+    trace::Scope scope("track sequence", "app");
+    SequenceResult result;
+    result.name = sequence.name;
+    result.load_ms = sequence.load_ms;
+
+    std::vector<Detection> detections;
+    std::chrono::steady_clock::duration tracking{};
+    int numFrames = sequence.getFrameCount();
+
+    for (int frameId = 1; frameId <= numFrames; ++frameId)
+    {
+        auto frameDetections = sequence.detections->getFrame(frameId);
+        detections.assign(frameDetections.begin(), frameDetections.end());
+
+        auto start = std::chrono::steady_clock::now();
+        tracker.update(detections);
+        tracking += std::chrono::steady_clock::now() - start;
+
+        result.frames++;
+        result.detections += detections.size();
+
+        if (out)
+            out->write(detections);
+        if (keep_tracks)
+            result.tracks.insert(result.tracks.end(), detections.begin(), detections.end());
+    }
+
+    if (out)
+        out->flush();
+
+    result.track_ms = std::chrono::duration<double, std::milli>(tracking).count();
+    return result;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <io/detection_file.hpp>
+#include <io/result_writer.hpp>
+#include <io/sequence.hpp>
+#include <tracking/tracker.hpp>
+
+// One MOT sequence with its detections loaded, shared by the batch tools
+struct SequenceData
+{
+    std::string name;
+    SequenceInfo info;
+    std::unique_ptr<DetectionFile> detections;
+    double load_ms = 0.;
+
+    int getFrameCount() const { return info.seqLength > 0 ? info.seqLength : detections->getLastFrame(); }
+};
+
+struct SequenceResult
+{
+    std::string name;
+    int frames = 0;
+    size_t detections = 0;
+    double load_ms = 0.;
+    double track_ms = 0.;
+    std::vector<Detection> tracks{}; // only filled when requested
+};
+
+// Loads seqinfo.ini and det/det.txt (gt/gt.txt with `gt`) of a sequence folder.
+// `features` names a .npy of embeddings inside the folder (e.g. det/det.npy), one row
+// per detection line, copied into Detection::features.
+SequenceData loadSequence(const std::filesystem::path &seqPath, bool gt, const std::filesystem::path &features = {});
+
+// Runs a fresh tracker over every frame of a sequence. Results go to `out` when given,
+// and are kept in SequenceResult::tracks with `keep_tracks`.
+SequenceResult runSequence(const SequenceData &sequence, BaseTracker &tracker, ResultWriter *out, bool keep_tracks = false);
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <print>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+
+#include <io/detection_file.hpp>
+#include <io/npy.hpp>
+#include <io/result_writer.hpp>
+#include <io/shm_ring.hpp>
+
+namespace fs = std::filesystem;
+
+// Detector stand-in for `mot --stream shm:<name>`: replays a sequence, or synthetic
+// frames, through the shared-memory ring and reports the tracker latency.
+int main(int argc, char **argv)
+{
+    argparse::ArgumentParser parser("mot-shm-producer");
+    parser.add_description("Feed detections to `mot --stream shm:<name>` and measure latency");
+    parser.add_argument("-n", "--name").default_value(std::string("mot")).help("Shared memory ring name");
+    parser.add_argument("-i", "--input").help("MOT sequence folder, synthetic frames otherwise");
+    parser.add_argument("-f", "--features").help("Embeddings (.npy, one row per det.txt line)");
+    parser.add_argument("-o", "--output").help("Write the returned tracks to this file");
+    parser.add_argument("--frames").default_value(1000).scan<'i', int>().help("Synthetic frames");
+    parser.add_argument("--detections").default_value(100).scan<'i', int>().help("Synthetic detections per frame");
+    parser.add_argument("--dim").default_value(0).scan<'i', int>().help("Synthetic embedding size");
+    parser.add_argument("--slots").default_value(8).scan<'i', int>().help("Ring slots");
+    parser.add_argument("--fps").default_value(0.).scan<'g', double>().help("Frames per second, 0 for as fast as possible");
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "{}", e.what());
+        std::cerr << parser;
+        return 1;
+    }
+
+    // Source frames
+    std::unique_ptr<DetectionFile> detFile;
+    std::unique_ptr<NpyArray> embeddings;
+    int numFrames = parser.get<int>("--frames");
+    uint32_t maxDetections = static_cast<uint32_t>(std::max(1, parser.get<int>("--detections")));
+    uint32_t featureDim = static_cast<uint32_t>(std::max(0, parser.get<int>("--dim")));
+
+    try
+    {
+        if (auto input = parser.present<std::string>("--input"))
+        {
+            detFile = std::make_unique<DetectionFile>(fs::path(*input) / "det/det.txt");
+            numFrames = detFile->getLastFrame();
+            maxDetections = 1;
+            for (int frameId = detFile->getFirstFrame(); frameId <= detFile->getLastFrame(); ++frameId)
+                maxDetections = std::max(maxDetections, static_cast<uint32_t>(detFile->getFrame(frameId).size()));
+
+            featureDim = 0;
+            if (auto features = parser.present<std::string>("--features"))
+            {
+                embeddings = std::make_unique<NpyArray>(*features);
+                if (embeddings->rows() != detFile->size())
+                {
+                    std::println(std::cerr, "{} has {} rows, expected {}", *features, embeddings->rows(), detFile->size());
+                    return 1;
+                }
+                featureDim = static_cast<uint32_t>(embeddings->cols());
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "Could not read input: {}", e.what());
+        return 1;
+    }
+
+    std::unique_ptr<ResultWriter> out;
+    if (auto output = parser.present<std::string>("--output"))
+        out = std::make_unique<ResultWriter>(fs::path(*output));
+
+    std::string name = parser.get("--name");
+    ShmRing ring = ShmRing::create(name, static_cast<uint32_t>(std::max(1, parser.get<int>("--slots"))), maxDetections, featureDim);
+    std::println(std::cerr, "Ring {}: {} slots of {} detections, {} features", name, ring.getNumSlots(), maxDetections, featureDim);
+
+    // Synthetic scene: boxes drifting at constant velocity
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(0.f, 1800.f);
+    std::uniform_real_distribution<float> velocity(-3.f, 3.f);
+    std::normal_distribution<float> noise(0.f, 1.f);
+    std::vector<cv::Point2f> origins(maxDetections), velocities(maxDetections);
+    for (uint32_t i = 0; i < maxDetections; ++i)
+    {
+        origins[i] = {position(rng), position(rng) * 0.5f};
+        velocities[i] = {velocity(rng), velocity(rng)};
+    }
+
+    std::vector<double> serviceLatencies, roundTrips;
+    std::vector<Detection> results;
+
+    auto collect = [&]()
+    {
+        ShmFrame done;
+        bool any = false;
+        while (ring.tryCollect(done))
+        {
+            uint64_t now = ShmRing::now();
+            serviceLatencies.push_back(static_cast<double>(done.processed_ns - done.published_ns) / 1e6);
+            roundTrips.push_back(static_cast<double>(now - done.published_ns) / 1e6);
+            any = true;
+
+            if (!out)
+                continue;
+            results.resize(done.detections.size());
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                const auto &slot = done.detections[i];
+                results[i].frame_id = done.frame_id;
+                results[i].track_id = slot.track_id;
+                results[i].confidence = slot.confidence;
+                results[i].bbox = cv::Rect2f(slot.x, slot.y, slot.w, slot.h);
+            }
+            out->write(results);
+        }
+        return any;
+    };
+
+    double fps = parser.get<double>("--fps");
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frameId = 1; frameId <= numFrames; ++frameId)
+    {
+        if (fps > 0.)
+            std::this_thread::sleep_until(start + std::chrono::duration<double>((frameId - 1) / fps));
+
+        // Wait for a free slot, collecting results meanwhile
+        ShmFrame frame;
+        while (!ring.tryAcquire(frame))
+        {
+            if (!collect())
+                std::this_thread::yield();
+        }
+
+        // Fill the slot in place
+        size_t count = 0;
+        frame.frame_id = frameId;
+        if (detFile)
+        {
+            auto dets = detFile->getFrame(frameId);
+            auto rows = detFile->getFrameRows(frameId);
+            for (; count < dets.size(); ++count)
+            {
+                const auto &det = dets[count];
+                frame.detections[count] = {det.bbox.x, det.bbox.y, det.bbox.width, det.bbox.height, det.confidence, det.class_id, -1, 0};
+                if (embeddings)
+                {
+                    auto feature = embeddings->row(rows[count]);
+                    std::copy(feature.begin(), feature.end(), frame.features.begin() + count * featureDim);
+                }
+            }
+        }
+        else
+        {
+            for (; count < maxDetections; ++count)
+            {
+                float x = origins[count].x + velocities[count].x * static_cast<float>(frameId);
+                float y = origins[count].y + velocities[count].y * static_cast<float>(frameId);
+                frame.detections[count] = {x + noise(rng), y + noise(rng), 40.f, 80.f, 0.9f, 0, -1, 0};
+                for (uint32_t d = 0; d < featureDim; ++d)
+                    frame.features[count * featureDim + d] = noise(rng);
+            }
+        }
+
+        ring.publish(frame, count);
+        collect();
+    }
+
+    // Drain the remaining results
+    ring.close();
+    while (roundTrips.size() < static_cast<size_t>(std::max(0, numFrames)))
+    {
+        if (!collect())
+            std::this_thread::yield();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    auto report = [](const char *label, std::vector<double> &latencies)
+    {
+        std::sort(latencies.begin(), latencies.end());
+        auto at = [&](double p)
+        { return latencies.empty() ? 0. : latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1) + 0.5)]; };
+        std::println(std::cerr, "{}: p50 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms", label, at(0.5), at(0.99), latencies.empty() ? 0. : latencies.back());
+    };
+
+    std::println(std::cerr, "{} frames in {:.2f} s ({:.1f} FPS)", numFrames, seconds, seconds > 0. ? numFrames / seconds : 0.);
+    report("publish to tracked", serviceLatencies);
+    report("round trip", roundTrips);
+
+    if (out)
+        out->flush();
+    return 0;
+}
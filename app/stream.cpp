@@ -0,0 +1,240 @@
+#include "stream.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <csignal>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <print>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <io/result_writer.hpp>
+#include <io/shm_ring.hpp>
+#include <io/stream_reader.hpp>
+
+#include "utility.hpp"
+
+namespace
+{
+    // Listens on `path` and accepts a single producer connection
+    int acceptUnixClient(const std::string &path)
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path))
+        {
+            std::println(std::cerr, "Socket path too long: {}", path);
+            return -1;
+        }
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+        int server = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (server < 0)
+        {
+            std::println(std::cerr, "Could not create socket: {}", std::strerror(errno));
+            return -1;
+        }
+
+        ::unlink(path.c_str());
+        if (::bind(server, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || ::listen(server, 1) < 0)
+        {
+            std::println(std::cerr, "Could not listen on {}: {}", path, std::strerror(errno));
+            ::close(server);
+            return -1;
+        }
+
+        std::println(std::cerr, "Waiting for a producer on {}", path);
+        int client = ::accept4(server, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0)
+            std::println(std::cerr, "Could not accept connection: {}", std::strerror(errno));
+
+        ::close(server);
+        ::unlink(path.c_str());
+        return client;
+    }
+
+    // Ingest-to-emit latency: frame received until its results are handed back
+    void reportLatency(std::vector<double> latencies)
+    {
+        std::sort(latencies.begin(), latencies.end());
+        std::println(std::cerr, "{} frames, latency p50 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+                     latencies.size(), percentile(latencies, 0.5), percentile(latencies, 0.99),
+                     latencies.empty() ? 0. : latencies.back());
+    }
+
+    // Spins briefly, then yields, then sleeps, so an idle consumer does not burn a core
+    void backoff(size_t idle)
+    {
+        if (idle < 64)
+            return;
+        if (idle < 1024)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    int runSharedMemory(const std::string &name, BaseTracker &tracker)
+    {
+        // Attach once the producer has created and initialised the ring
+        std::optional<ShmRing> ring;
+        bool waiting = false;
+        while (!ring)
+        {
+            try
+            {
+                ring = ShmRing::tryOpen(name);
+            }
+            catch (const std::system_error &e)
+            {
+                // Not created yet; permission or mapping failures will not go away
+                if (e.code() != std::errc::no_such_file_or_directory)
+                {
+                    std::println(std::cerr, "{}", e.what());
+                    return 1;
+                }
+            }
+            catch (const std::exception &e)
+            {
+                std::println(std::cerr, "{}", e.what());
+                return 1;
+            }
+
+            if (!ring)
+            {
+                if (!waiting)
+                    std::println(std::cerr, "Waiting for a producer on shared memory {}", name);
+                waiting = true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+
+        std::vector<double> latencies;
+        std::vector<Detection> detections;
+        ShmFrame frame;
+        size_t idle = 0;
+
+        while (true)
+        {
+            if (!ring->tryReceive(frame))
+            {
+                if (ring->finished())
+                    break;
+                backoff(idle++);
+                continue;
+            }
+            idle = 0;
+
+            // Detection owns its features, so embeddings are copied into the reused buffer
+            detections.resize(frame.detections.size());
+            for (size_t i = 0; i < detections.size(); ++i)
+            {
+                const auto &slot = frame.detections[i];
+                auto &det = detections[i];
+                det.frame_id = frame.frame_id;
+                det.track_id = -1;
+                det.class_id = slot.class_id;
+                det.confidence = slot.confidence;
+                det.bbox = cv::Rect2f(slot.x, slot.y, slot.w, slot.h);
+                auto feature = frame.features.subspan(i * frame.feature_dim, frame.feature_dim);
+                det.features.assign(feature.begin(), feature.end());
+            }
+
+            tracker.update(detections);
+
+            // Track ids go back into the producer's slot
+            for (size_t i = 0; i < detections.size(); ++i)
+                frame.detections[i].track_id = detections[i].track_id;
+            ring->complete(frame);
+
+            latencies.push_back(static_cast<double>(frame.processed_ns - frame.published_ns) / 1e6);
+        }
+
+        reportLatency(std::move(latencies));
+        return 0;
+    }
+}
+
+int runStream(const std::string &endpoint, BaseTracker &tracker)
+{
+    if (endpoint.starts_with("shm:"))
+        return runSharedMemory(endpoint.substr(4), tracker);
+
+    int inFd = STDIN_FILENO;
+    int outFd = STDOUT_FILENO;
+    int client = -1;
+
+    if (endpoint.starts_with("unix:"))
+    {
+        client = acceptUnixClient(endpoint.substr(5));
+        if (client < 0)
+            return 1;
+        inFd = client;
+        outFd = client;
+    }
+    else if (endpoint != "stdin")
+    {
+        std::println(std::cerr, "Unknown stream endpoint: {} (expected stdin, unix:<path> or shm:<name>)", endpoint);
+        return 1;
+    }
+
+    // A producer closing its end must not kill the tracker
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<double> latencies;
+    std::vector<StreamReader::Clock::time_point> batch;
+    StreamReader::Frame frame;
+    int status = 0;
+
+    try
+    {
+        StreamReader reader(inFd);
+        ResultWriter writer(outFd);
+
+        bool open = true;
+        while (open)
+        {
+            open = reader.poll(-1);
+
+            // Track every complete frame, then flush the whole batch at once
+            batch.clear();
+            while (reader.nextFrame(frame))
+            {
+                tracker.update(frame.detections);
+                writer.write(frame.detections);
+                writer.endFrame();
+                batch.push_back(frame.received);
+            }
+
+            if (batch.empty())
+                continue;
+
+            writer.flush();
+            auto emitted = StreamReader::Clock::now();
+            for (const auto &received : batch)
+                latencies.push_back(std::chrono::duration<double, std::milli>(emitted - received).count());
+        }
+
+        if (reader.getSkippedLines() > 0)
+            std::println(std::cerr, "Skipped {} malformed lines", reader.getSkippedLines());
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "Stream failed: {}", e.what());
+        status = 1;
+    }
+
+    if (client >= 0)
+        ::close(client);
+
+    reportLatency(std::move(latencies));
+    return status;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+#include <tracking/tracker.hpp>
+
+// Streaming mode: detections arrive as MOT lines with an empty line after every frame,
+// on stdin ("stdin") or on a Unix domain socket the app listens on ("unix:<path>").
+// Results of every frame are sent back in the same framing, on stdout or the socket.
+// With "shm:<name>", frames are consumed in place from a shared-memory ShmRing and
+// track ids are written back into its slots.
+int runStream(const std::string &endpoint, BaseTracker &tracker);
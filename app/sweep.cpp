@@ -0,0 +1,399 @@
+#include <atomic>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <print>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+
+#include <metrics/mot_metrics.hpp>
+#include <parallel/thread_pool.hpp>
+#include <tracking/factory.hpp>
+
+#include "runner.hpp"
+
+namespace fs = std::filesystem;
+
+// One swept config field: `key=v1,v2,...` or `key=lo:hi[:step]`.
+// Keys are `field` or `table.field` (e.g. kalman.process_noise_scale).
+struct Parameter
+{
+    std::string key;
+    std::vector<std::string> values{}; // explicit values, or the expanded range
+    double low = 0.;
+    double high = 0.;
+    double step = 0.;
+};
+
+static double toDouble(std::string_view text)
+{
+    double value;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc() || ptr != text.data() + text.size())
+        throw std::invalid_argument("Not a number: " + std::string(text));
+    return value;
+}
+
+static Parameter parseParameter(const std::string &spec)
+{
+    auto eq = spec.find('=');
+    if (eq == std::string::npos || eq == 0 || eq + 1 == spec.size())
+        throw std::invalid_argument("Expected key=values, got " + spec);
+
+    Parameter param;
+    param.key = spec.substr(0, eq);
+    std::string_view values(spec.data() + eq + 1, spec.size() - eq - 1);
+
+    if (values.find(':') != std::string_view::npos)
+    {
+        size_t first = values.find(':');
+        size_t second = values.find(':', first + 1);
+        param.low = toDouble(values.substr(0, first));
+        param.high = toDouble(values.substr(first + 1, second == std::string_view::npos ? std::string_view::npos : second - first - 1));
+        if (second != std::string_view::npos)
+        {
+            param.step = toDouble(values.substr(second + 1));
+            if (param.step <= 0.)
+                throw std::invalid_argument("Step must be positive in " + spec);
+            for (double v = param.low; v <= param.high + 1e-9 * param.step; v += param.step)
+                param.values.push_back(std::format("{:.6g}", v));
+        }
+        return param;
+    }
+
+    for (size_t begin = 0; begin <= values.size();)
+    {
+        size_t end = values.find(',', begin);
+        if (end == std::string_view::npos)
+            end = values.size();
+        param.values.emplace_back(values.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return param;
+}
+
+// Sets `key = value` in TOML text. Keys with a dot address a [table], a missing key is
+// added right after its table header (or at the top for root keys).
+static std::string setTomlValue(const std::string &toml, const std::string &key, const std::string &value)
+{
+    auto dot = key.rfind('.');
+    std::string table = dot == std::string::npos ? "" : key.substr(0, dot);
+    std::string field = dot == std::string::npos ? key : key.substr(dot + 1);
+
+    std::istringstream in(toml);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);)
+        lines.push_back(line);
+
+    auto trim = [](std::string_view s)
+    {
+        auto begin = s.find_first_not_of(" \t\r");
+        auto end = s.find_last_not_of(" \t\r");
+        return begin == std::string_view::npos ? std::string_view{} : s.substr(begin, end - begin + 1);
+    };
+
+    std::string current;
+    std::optional<size_t> header = table.empty() ? std::optional<size_t>(0) : std::nullopt;
+    bool replaced = false;
+    for (size_t i = 0; i < lines.size() && !replaced; ++i)
+    {
+        auto text = trim(lines[i]);
+        if (text.starts_with('['))
+        {
+            current = std::string(trim(text.substr(1, text.find(']') - 1)));
+            if (current == table)
+                header = i + 1;
+            continue;
+        }
+        auto eq = text.find('=');
+        if (current == table && eq != std::string_view::npos && trim(text.substr(0, eq)) == field)
+        {
+            lines[i] = field + " = " + value;
+            replaced = true;
+        }
+    }
+
+    if (!replaced)
+    {
+        if (header)
+            lines.insert(lines.begin() + static_cast<std::ptrdiff_t>(*header), field + " = " + value);
+        else
+        {
+            lines.push_back("[" + table + "]");
+            lines.push_back(field + " = " + value);
+        }
+    }
+
+    std::string out;
+    for (const auto &line : lines)
+        out += line + "\n";
+    return out;
+}
+
+struct Candidate
+{
+    std::vector<std::string> values{}; // one per parameter
+    std::string toml;
+};
+
+// Every combination of the parameter values, last parameter varying fastest
+static std::vector<std::vector<std::string>> expandGrid(const std::vector<Parameter> &params)
+{
+    std::vector<std::vector<std::string>> grid{{}};
+    for (const auto &param : params)
+    {
+        if (param.values.empty())
+            throw std::invalid_argument("Grid search needs values or a step for " + param.key);
+
+        std::vector<std::vector<std::string>> next;
+        next.reserve(grid.size() * param.values.size());
+        for (const auto &prefix : grid)
+            for (const auto &value : param.values)
+            {
+                next.push_back(prefix);
+                next.back().push_back(value);
+            }
+        grid = std::move(next);
+    }
+    return grid;
+}
+
+static std::vector<std::vector<std::string>> sampleRandom(const std::vector<Parameter> &params, size_t count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<std::vector<std::string>> samples(count);
+    for (auto &sample : samples)
+    {
+        for (const auto &param : params)
+        {
+            if (!param.values.empty())
+            {
+                std::uniform_int_distribution<size_t> pick(0, param.values.size() - 1);
+                sample.push_back(param.values[pick(rng)]);
+            }
+            else
+            {
+                std::uniform_real_distribution<double> uniform(param.low, param.high);
+                sample.push_back(std::format("{:.6g}", uniform(rng)));
+            }
+        }
+    }
+    return samples;
+}
+
+// Tracks every sequence of a dataset split with many configs and scores each one in-process
+int main(int argc, char **argv)
+{
+    argparse::ArgumentParser parser("mot-sweep");
+    parser.add_description("Grid or random search over tracker config fields");
+    parser.add_argument("-d", "--dataset").required().help("Path to dataset (e.g. data/MOT20)");
+    parser.add_argument("-s", "--split").default_value(std::string("train")).help("Dataset split, with ground truth");
+    parser.add_argument("-c", "--config").required().help("Base tracker config.toml");
+    parser.add_argument("-p", "--param").append().required().help("Swept field, key=v1,v2,... or key=lo:hi[:step]");
+    parser.add_argument("-n", "--random").default_value(0).scan<'i', int>().help("Random search with this many configs instead of a grid");
+    parser.add_argument("--seed").default_value(0).scan<'i', int>().help("Random search seed");
+    parser.add_argument("-o", "--output").default_value(std::string("sweep.csv")).help("Results CSV, one row per config");
+    parser.add_argument("-f", "--features").help("Embeddings .npy inside each sequence folder (e.g. det/det.npy)");
+    parser.add_argument("-j", "--threads").default_value(0).scan<'i', int>().help("Worker threads, 0 uses all cores");
+    parser.add_argument("--gt").flag().help("Track ground-truth detections");
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "{}", e.what());
+        std::cerr << parser;
+        return 1;
+    }
+
+    std::ifstream configFile(parser.get("--config"));
+    if (!configFile.is_open())
+    {
+        std::println(std::cerr, "Could not open config file: {}", parser.get("--config"));
+        return 1;
+    }
+    std::stringstream config;
+    config << configFile.rdbuf();
+    std::string baseToml = config.str();
+
+    // Expand the search space, every config is validated before anything runs
+    std::vector<Parameter> params;
+    std::vector<Candidate> candidates;
+    try
+    {
+        for (const auto &spec : parser.get<std::vector<std::string>>("--param"))
+            params.push_back(parseParameter(spec));
+
+        int random = parser.get<int>("--random");
+        auto combinations = random > 0 ? sampleRandom(params, static_cast<size_t>(random), static_cast<unsigned>(parser.get<int>("--seed")))
+                                       : expandGrid(params);
+
+        for (auto &values : combinations)
+        {
+            Candidate candidate{std::move(values), baseToml};
+            for (size_t p = 0; p < params.size(); ++p)
+                candidate.toml = setTomlValue(candidate.toml, params[p].key, candidate.values[p]);
+            TrackerFactory::createFromString(candidate.toml);
+            candidates.push_back(std::move(candidate));
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "Invalid sweep: {}", e.what());
+        return 1;
+    }
+
+    fs::path splitPath = fs::path(parser.get("--dataset")) / parser.get("--split");
+    std::vector<fs::path> seqPaths;
+    if (fs::is_directory(splitPath))
+        for (const auto &seqPath : listSequences(splitPath))
+            if (fs::exists(seqPath / "gt/gt.txt"))
+                seqPaths.push_back(seqPath);
+    if (seqPaths.empty())
+    {
+        std::println(std::cerr, "No sequences with ground truth in {}", splitPath.string());
+        return 1;
+    }
+
+    int threads = parser.get<int>("--threads");
+    ThreadPool pool(threads > 0 ? static_cast<size_t>(threads) : std::thread::hardware_concurrency());
+
+    // Detections, embeddings and ground truth are loaded once and shared read-only
+    bool gt = parser.get<bool>("--gt");
+    fs::path features = parser.present("--features").value_or("");
+    std::vector<SequenceData> sequences(seqPaths.size());
+    std::vector<std::unique_ptr<DetectionFile>> groundTruth(seqPaths.size());
+    try
+    {
+        std::vector<std::future<void>> loads;
+        for (size_t s = 0; s < seqPaths.size(); ++s)
+            loads.push_back(pool.submit([&, s]()
+                                        {
+                sequences[s] = loadSequence(seqPaths[s], gt, features);
+                groundTruth[s] = std::make_unique<DetectionFile>(seqPaths[s] / "gt/gt.txt"); }));
+        for (auto &load : loads)
+            load.get();
+    }
+    catch (const std::exception &e)
+    {
+        std::println(std::cerr, "Could not load sequences: {}", e.what());
+        return 1;
+    }
+
+    size_t numDetections = 0;
+    for (const auto &sequence : sequences)
+        numDetections += sequence.detections->size();
+    std::println(std::cerr, "{} configs x {} sequences ({} detections) on {} threads",
+                 candidates.size(), sequences.size(), numDetections, pool.size());
+
+    std::ofstream csv(parser.get("--output"));
+    if (!csv.is_open())
+    {
+        std::println(std::cerr, "Could not open {}", parser.get("--output"));
+        return 1;
+    }
+    csv << "config";
+    for (const auto &param : params)
+        csv << "," << param.key;
+    csv << ",hota,deta,assa,mota,motp,idf1,ids,fp,fn,track_ms\n";
+    csv.flush();
+
+    // Every (config, sequence) pair is a task. A config's row is written as soon as its
+    // last sequence is scored, so partial results survive an interrupted sweep.
+    struct Pending
+    {
+        MotMetrics metrics{};
+        double track_ms = 0.;
+        size_t remaining = 0;
+        std::string error{};
+    };
+    std::vector<Pending> pending(candidates.size());
+    for (auto &entry : pending)
+        entry.remaining = sequences.size();
+
+    std::mutex mutex;
+    std::atomic<size_t> done{0};
+    size_t best = candidates.size();
+    double bestHota = -1.;
+    MetricsConfig metricsConfig;
+
+    auto finish = [&](size_t c)
+    {
+        // Called with the mutex held
+        const auto &entry = pending[c];
+        if (!entry.error.empty())
+        {
+            std::println(std::cerr, "Config {}: {}", c, entry.error);
+            return;
+        }
+
+        const auto &m = entry.metrics;
+        csv << c;
+        for (const auto &value : candidates[c].values)
+            csv << "," << value;
+        csv << std::format(",{:.6f},{:.6f},{:.6f},{:.6f},{:.6f},{:.6f},{},{},{},{:.1f}\n",
+                           m.hota(), m.deta(), m.assa(), m.mota(), m.motp(), m.idf1(),
+                           m.switches, m.false_positives, m.misses, entry.track_ms);
+        csv.flush();
+
+        if (m.hota() > bestHota)
+        {
+            bestHota = m.hota();
+            best = c;
+        }
+
+        size_t count = ++done;
+        if (count % 10 == 0 || count == candidates.size())
+            std::println(std::cerr, "{}/{} configs, best HOTA {:.2f}% (config {})", count, candidates.size(), 100. * bestHota, best);
+    };
+
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(candidates.size() * sequences.size());
+    for (size_t c = 0; c < candidates.size(); ++c)
+        for (size_t s = 0; s < sequences.size(); ++s)
+            tasks.push_back(pool.submit([&, c, s]()
+                                        {
+                MotMetrics metrics;
+                SequenceResult result;
+                std::string error;
+                try
+                {
+                    auto tracker = TrackerFactory::createFromString(candidates[c].toml);
+                    result = runSequence(sequences[s], *tracker, nullptr, true);
+                    metrics = evaluateMot(groundTruth[s]->getDetections(), result.tracks, metricsConfig);
+                }
+                catch (const std::exception &e)
+                {
+                    error = e.what();
+                }
+
+                std::lock_guard lock(mutex);
+                auto &entry = pending[c];
+                entry.metrics += metrics;
+                entry.track_ms += result.track_ms;
+                if (!error.empty())
+                    entry.error = sequences[s].name + ": " + error;
+                if (--entry.remaining == 0)
+                    finish(c); }));
+
+    for (auto &task : tasks)
+        task.get();
+
+    if (best == candidates.size())
+        return 1;
+
+    std::println("Best config {} (HOTA {:.2f}%):", best, 100. * bestHota);
+    for (size_t p = 0; p < params.size(); ++p)
+        std::println("  {} = {}", params[p].key, candidates[best].values[p]);
+    return 0;
+}
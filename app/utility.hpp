@@ -0,0 +1,15 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+
+// Helpers shared by the command-line tools. JSON strings are escaped with trace::escape.
+
+// Nearest-rank percentile of values sorted in ascending order, 0 when empty
+inline double percentile(std::span<const double> sorted, double p)
+{
+    if (sorted.empty())
+        return 0.;
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
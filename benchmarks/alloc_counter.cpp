@@ -0,0 +1,84 @@
+#include "alloc_counter.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<bool> counting{false};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+
+    void count(std::size_t size)
+    {
+        if (counting.load(std::memory_order_relaxed))
+        {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+            bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+    }
+
+    void *allocate(std::size_t size, std::size_t alignment)
+    {
+        count(size);
+        size = size ? size : 1;
+        void *ptr = alignment > alignof(std::max_align_t)
+                        ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+                        : std::malloc(size);
+        if (!ptr)
+            throw std::bad_alloc();
+        return ptr;
+    }
+}
+
+namespace alloc_counter
+{
+    void enable(bool on)
+    {
+        counting.store(on, std::memory_order_relaxed);
+    }
+
+    bool enabled()
+    {
+        return counting.load(std::memory_order_relaxed);
+    }
+
+    Counts read()
+    {
+        return {allocations.load(std::memory_order_relaxed), bytes.load(std::memory_order_relaxed)};
+    }
+}
+
+// The array and nothrow forms forward to these by default. The sized deletes are
+// replaced too: with -Wextra GCC requires them alongside the unsized ones.
+void *operator new(std::size_t size)
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+// Counting replacement of the global operator new / delete, linked into the benchmarks only.
+// Counting is off until enable(), then every allocation of every thread is counted.
+namespace alloc_counter
+{
+    struct Counts
+    {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+
+        Counts operator-(const Counts &other) const { return {allocations - other.allocations, bytes - other.bytes}; }
+        Counts &operator+=(const Counts &other)
+        {
+            allocations += other.allocations;
+            bytes += other.bytes;
+            return *this;
+        }
+    };
+
+    void enable(bool on = true);
+    bool enabled();
+
+    // Totals since the process started, only the part made while enabled
+    Counts read();
+}
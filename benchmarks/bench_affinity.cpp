@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <assignment/affinity.hpp>
+#include <utils/geometry_utils.hpp>
+
+#include "scene.hpp"
+
+// Detections x tracks of the same scene, one frame apart
+struct Pairs
+{
+    std::vector<Detection> detections{};
+    std::vector<cv::Rect2f> tracks{};
+    std::vector<std::vector<float>> track_features{};
+
+    Pairs(size_t n, size_t feature_dim = 0)
+    {
+        auto scene = makeScene(n, feature_dim);
+        scene.next(detections);
+        tracks = scene.getBoxes();
+        for (const auto &det : detections)
+            track_features.push_back(det.features);
+        scene.next(detections);
+    }
+};
+
+// Pairwise getIoU into a cv::Mat, as the trackers build their cost matrix
+static void BM_IoUMatrix(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Pairs pairs(n);
+    cv::Mat_<float> cost(static_cast<int>(n), static_cast<int>(n));
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                cost(static_cast<int>(i), static_cast<int>(j)) = getIoU(pairs.detections[i].bbox, pairs.tracks[j]);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+// Structure-of-arrays kernel of affinity.hpp
+static void BM_IoUMatrixSoA(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Pairs pairs(n);
+    affinity::Boxes a, b;
+    for (const auto &det : pairs.detections)
+        a.push_back(det.bbox);
+    for (const auto &box : pairs.tracks)
+        b.push_back(box);
+    std::vector<float> cost(n * n);
+
+    for (auto _ : state)
+    {
+        affinity::iou(a, 0, n, b, 0, n, cost.data(), n);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+static void BM_CosineMatrix(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Pairs pairs(n, static_cast<size_t>(state.range(1)));
+    cv::Mat_<float> cost(static_cast<int>(n), static_cast<int>(n));
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                cost(static_cast<int>(i), static_cast<int>(j)) = cosineSimilarity(pairs.detections[i].features, pairs.track_features[j]);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+
+BENCHMARK(BM_IoUMatrix)->Apply(objectCounts)->Complexity(benchmark::oNSquared)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_IoUMatrixSoA)->Apply(objectCounts)->Complexity(benchmark::oNSquared)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CosineMatrix)->ArgsProduct({{10, 50, 100, 500, 1000}, {128, 512}})->ArgNames({"n", "dim"})->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <assignment/hungarian.hpp>
+
+#include "scene.hpp"
+
+// Square n x n max-cost assignment, with `density` percent of the cells non-zero
+// (IoU cost matrices of sparse scenes are mostly zero)
+static void BM_Hungarian(benchmark::State &state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const double density = static_cast<double>(state.range(1)) / 100.;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> value(0.f, 1.f);
+    std::bernoulli_distribution keep(density);
+    cv::Mat_<float> cost(n, n, 0.f);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            if (keep(rng))
+                cost(i, j) = value(rng);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(hungarian::max_cost_assignment(cost));
+
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_Hungarian)
+    ->ArgsProduct({{10, 50, 100, 500, 1000, 5000}, {1, 10, 100}})
+    ->ArgNames({"n", "density"})
+    ->Unit(benchmark::kMillisecond);
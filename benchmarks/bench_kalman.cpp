@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include <kalman/xysr.hpp>
+#include <kalman/xywh.hpp>
+
+#include "scene.hpp"
+
+template <typename Filter>
+static std::vector<std::unique_ptr<BaseKalmanFilter>> makeFilters(const std::vector<cv::Rect2f> &boxes)
+{
+    std::vector<std::unique_ptr<BaseKalmanFilter>> filters;
+    for (const auto &box : boxes)
+        filters.push_back(std::make_unique<Filter>(box));
+    return filters;
+}
+
+template <typename Filter>
+static void BM_KalmanPredict(benchmark::State &state)
+{
+    auto scene = makeScene(static_cast<size_t>(state.range(0)));
+    auto filters = makeFilters<Filter>(scene.getBoxes());
+
+    for (auto _ : state)
+        for (auto &filter : filters)
+            benchmark::DoNotOptimize(filter->predict());
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+// Predict then correct, what a matched track does every frame
+template <typename Filter>
+static void BM_KalmanUpdate(benchmark::State &state)
+{
+    auto scene = makeScene(static_cast<size_t>(state.range(0)));
+    auto filters = makeFilters<Filter>(scene.getBoxes());
+    std::vector<Detection> detections;
+    scene.next(detections);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < filters.size(); ++i)
+        {
+            filters[i]->predict();
+            filters[i]->update(detections[i].bbox);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_KalmanPredict<KalmanFilterXYWH>)->Apply(objectCounts)->Complexity(benchmark::oN);
+BENCHMARK(BM_KalmanPredict<KalmanFilterXYSR>)->Apply(objectCounts)->Complexity(benchmark::oN);
+BENCHMARK(BM_KalmanUpdate<KalmanFilterXYWH>)->Apply(objectCounts)->Complexity(benchmark::oN);
+BENCHMARK(BM_KalmanUpdate<KalmanFilterXYSR>)->Apply(objectCounts)->Complexity(benchmark::oN);
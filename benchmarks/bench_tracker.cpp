@@ -0,0 +1,215 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include <tracking/botsort.hpp>
+#include <tracking/multistream.hpp>
+#include <tracking/sort.hpp>
+#include <tracking/tiled.hpp>
+
+#include "alloc_counter.hpp"
+#include "scene.hpp"
+
+// Per-stage mean latency, plus IPC and cache / branch misses per call when hardware counters are readable
+static void reportStages(benchmark::State &state, const TrackerProfiler &profiler)
+{
+    for (size_t i = 0; i < NUM_TRACKER_STAGES; ++i)
+    {
+        auto stage = static_cast<TrackerStage>(i);
+        auto stats = profiler.getStats(stage);
+        std::string name = stageName(stage);
+        state.counters[name + "_us"] = stats.mean_us;
+        if (stats.has_counters)
+        {
+            state.counters[name + "_ipc"] = stats.ipc();
+            state.counters[name + "_llc_miss"] = stats.cache_misses;
+            state.counters[name + "_br_miss"] = stats.branch_misses;
+        }
+    }
+    if (!profiler.hasCounters())
+        state.SetLabel("no perf counters: " + profiler.getCounterError());
+}
+
+// Tracker state after the run, and heap traffic of update() with --count_allocations
+static void reportMemory(benchmark::State &state, const BaseTracker &tracker, const alloc_counter::Counts &allocated)
+{
+    auto report = tracker.getMemoryReport();
+    state.counters["state_kb"] = static_cast<double>(report.total()) / 1024.;
+    if (report.num_tracks)
+        state.counters["bytes_per_track"] = static_cast<double>(report.total()) / static_cast<double>(report.num_tracks);
+    if (alloc_counter::enabled())
+    {
+        auto perUpdate = [&](uint64_t value)
+        { return benchmark::Counter(static_cast<double>(value), benchmark::Counter::kAvgIterations); };
+        state.counters["allocs"] = perUpdate(allocated.allocations);
+        state.counters["alloc_bytes"] = perUpdate(allocated.bytes);
+    }
+}
+
+static std::shared_ptr<TrackerProfiler> makeProfiler()
+{
+    auto profiler = std::make_shared<TrackerProfiler>();
+    profiler->enableCounters();
+    return profiler;
+}
+
+// Steady-state update: tracks are confirmed during warm-up, then every iteration is one
+// frame of the same moving crowd
+template <typename Tracker, typename Config>
+static void runTracker(benchmark::State &state, const Config &config, size_t feature_dim,
+                       std::shared_ptr<TrackerProfiler> profiler = nullptr)
+{
+    auto scene = makeScene(static_cast<size_t>(state.range(0)), feature_dim);
+    Tracker tracker(config);
+    tracker.setProfiler(profiler);
+    std::vector<Detection> detections;
+    for (int warmup = 0; warmup < 5; ++warmup)
+    {
+        scene.next(detections);
+        tracker.update(detections);
+    }
+
+    alloc_counter::Counts allocated;
+    for (auto _ : state)
+    {
+        scene.next(detections);
+        auto before = alloc_counter::read();
+        tracker.update(detections);
+        allocated += alloc_counter::read() - before;
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+    state.counters["fps"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+    reportMemory(state, tracker, allocated);
+    if (profiler)
+        reportStages(state, *profiler);
+}
+
+static void BM_SortUpdate(benchmark::State &state)
+{
+    runTracker<Sort>(state, SortConfig{}, 0);
+}
+
+// Same with stage profiling enabled: the difference is the instrumentation overhead, the
+// stage counters show where the time goes
+static void BM_SortUpdateProfiled(benchmark::State &state)
+{
+    runTracker<Sort>(state, SortConfig{}, 0, makeProfiler());
+}
+
+static void BM_BotSortUpdate(benchmark::State &state)
+{
+    runTracker<BotSort>(state, BotSortConfig{}, 128);
+}
+
+static void BM_BotSortUpdateProfiled(benchmark::State &state)
+{
+    runTracker<BotSort>(state, BotSortConfig{}, 128, makeProfiler());
+}
+
+// Dense crowds split over 1080p tiles, where the plain trackers' N x N matrices stop scaling
+static void BM_TiledSortCrowd(benchmark::State &state)
+{
+    CrowdConfig config;
+    config.num_objects = static_cast<size_t>(state.range(0));
+    config.seed = 42;
+    config.miss_rate = 0.05f;
+    config.false_positive_rate = 0.02f;
+    CrowdGenerator crowd(config);
+
+    TilingConfig tiling;
+    tiling.tile_width = 1920.f;
+    tiling.tile_height = 1080.f;
+    tiling.overlap = 128.f;
+    tiling.num_threads = 1;
+    TiledTracker tracker(tiling, []()
+                         { return std::make_unique<Sort>(SortConfig{}); });
+
+    std::vector<Detection> detections;
+    for (int warmup = 0; warmup < 5; ++warmup)
+    {
+        crowd.next(detections);
+        tracker.update(detections);
+    }
+
+    alloc_counter::Counts allocated;
+    for (auto _ : state)
+    {
+        crowd.next(detections);
+        auto before = alloc_counter::read();
+        tracker.update(detections);
+        allocated += alloc_counter::read() - before;
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+    state.counters["fps"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+    reportMemory(state, tracker, allocated);
+}
+
+// Independent crowds, one per stream, on a pool of state.range(0) workers. Every iteration
+// is one frame of every stream; fps counts stream frames, so it should grow with the workers
+// up to the number of cores.
+static void BM_MultiStream(benchmark::State &state)
+{
+    constexpr size_t num_streams = 16;
+    constexpr size_t num_objects = 200;
+
+    std::vector<CrowdGenerator> scenes;
+    std::vector<std::unique_ptr<BaseTracker>> trackers;
+    for (size_t i = 0; i < num_streams; ++i)
+    {
+        scenes.push_back(makeScene(num_objects));
+        trackers.push_back(std::make_unique<Sort>(SortConfig{}));
+    }
+    MultiStreamTracker tracker(std::move(trackers), static_cast<size_t>(state.range(0)));
+
+    std::vector<std::vector<Detection>> frames(num_streams);
+    auto nextFrames = [&]()
+    {
+        for (size_t i = 0; i < num_streams; ++i)
+            scenes[i].next(frames[i]);
+    };
+    for (int warmup = 0; warmup < 5; ++warmup)
+    {
+        nextFrames();
+        for (size_t i = 0; i < num_streams; ++i)
+            tracker.submit(i, frames[i]);
+        tracker.wait();
+    }
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        nextFrames();
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < num_streams; ++i)
+            tracker.submit(i, frames[i]);
+        tracker.wait();
+    }
+
+    auto frames_done = static_cast<double>(state.iterations() * num_streams);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_streams * num_objects));
+    state.counters["fps"] = benchmark::Counter(frames_done, benchmark::Counter::kIsRate);
+    state.counters["workers"] = static_cast<double>(tracker.getPool().size());
+}
+
+// Worker counts from 1 to the number of cores, doubling
+static void workerCounts(benchmark::internal::Benchmark *bench)
+{
+    int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int n = 1; n < cores; n *= 2)
+        bench->Arg(n);
+    bench->Arg(cores);
+}
+
+BENCHMARK(BM_SortUpdate)->Apply(objectCounts)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SortUpdateProfiled)->Apply(objectCounts)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BotSortUpdate)->Apply(objectCounts)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BotSortUpdateProfiled)->Apply(objectCounts)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TiledSortCrowd)->RangeMultiplier(10)->Range(100, 10000)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MultiStream)->Apply(workerCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,26 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+
+#include "alloc_counter.hpp"
+
+// BENCHMARK_MAIN(), plus --count_allocations to report heap allocations per tracker update
+int main(int argc, char **argv)
+{
+    int kept = 1;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--count_allocations") == 0)
+            alloc_counter::enable();
+        else
+            argv[kept++] = argv[i];
+    }
+    argc = kept;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
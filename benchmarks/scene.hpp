@@ -0,0 +1,23 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <synthetic/crowd.hpp>
+
+// Seeded crowd at constant density: the canvas grows with the number of objects. Every
+// object is detected every frame, so detections line up with getBoxes().
+inline CrowdGenerator makeScene(size_t num_objects, size_t feature_dim = 0)
+{
+    CrowdConfig config;
+    config.num_objects = num_objects;
+    config.feature_dim = feature_dim;
+    config.seed = 42;
+    return CrowdGenerator(config);
+}
+
+// Objects per frame covered by the scaling benchmarks
+inline void objectCounts(benchmark::internal::Benchmark *bench)
+{
+    for (int n : {10, 50, 100, 500, 1000, 5000})
+        bench->Arg(n);
+}
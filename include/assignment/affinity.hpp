@@ -0,0 +1,69 @@
+#pragma once
+#include <opencv2/core.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace affinity {
+
+// Structure-of-arrays box storage, so that pairwise kernels run over
+// contiguous float lanes instead of strided cv::Rect2f fields.
+struct Boxes
+{
+    std::vector<float> x1, y1, x2, y2, area;
+
+    size_t size() const { return x1.size(); }
+
+    void clear()
+    {
+        x1.clear(); y1.clear(); x2.clear(); y2.clear(); area.clear();
+    }
+
+    void reserve(size_t n)
+    {
+        x1.reserve(n); y1.reserve(n); x2.reserve(n); y2.reserve(n); area.reserve(n);
+    }
+
+    size_t capacityBytes() const
+    {
+        return (x1.capacity() + y1.capacity() + x2.capacity() + y2.capacity() + area.capacity()) * sizeof(float);
+    }
+
+    void push_back(const cv::Rect2f& rect)
+    {
+        x1.push_back(rect.x);
+        y1.push_back(rect.y);
+        x2.push_back(rect.x + rect.width);
+        y2.push_back(rect.y + rect.height);
+        area.push_back(rect.width * rect.height);
+    }
+};
+
+// out[i * stride + j] = IoU(a[a_begin + i], b[b_begin + j])
+// The inner loop is branch-free so the compiler can vectorise it across b.
+inline void iou(const Boxes& a, size_t a_begin, size_t a_end,
+                const Boxes& b, size_t b_begin, size_t b_end,
+                float* out, size_t stride)
+{
+    const size_t n = b_end - b_begin;
+    const float* __restrict bx1 = b.x1.data() + b_begin;
+    const float* __restrict by1 = b.y1.data() + b_begin;
+    const float* __restrict bx2 = b.x2.data() + b_begin;
+    const float* __restrict by2 = b.y2.data() + b_begin;
+    const float* __restrict barea = b.area.data() + b_begin;
+
+    for (size_t i = a_begin; i < a_end; ++i)
+    {
+        const float ax1 = a.x1[i], ay1 = a.y1[i], ax2 = a.x2[i], ay2 = a.y2[i], aarea = a.area[i];
+        float* __restrict row = out + (i - a_begin) * stride;
+        for (size_t j = 0; j < n; ++j)
+        {
+            float w = std::max(0.f, std::min(ax2, bx2[j]) - std::max(ax1, bx1[j]));
+            float h = std::max(0.f, std::min(ay2, by2[j]) - std::max(ay1, by1[j]));
+            float inter = w * h;
+            float uni = aarea + barea[j] - inter;
+            row[j] = uni > 0.f ? inter / uni : 0.f;
+        }
+    }
+}
+
+} // namespace affinity
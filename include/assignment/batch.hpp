@@ -0,0 +1,104 @@
+#pragma once
+#include <assignment/hungarian.hpp>
+#include <vector>
+
+namespace hungarian {
+
+// Many independent square max-cost problems packed back to back in a single
+// buffer. Buffers are kept across clear() so steady-state batches do not
+// allocate, and every problem owns disjoint slices so they can be solved in
+// any order.
+class AssignmentBatch
+{
+public:
+    void clear()
+    {
+        dims.clear();
+        cost_offsets.clear();
+        row_offsets.clear();
+        costs.clear();
+        total_rows = 0;
+    }
+
+    // Appends a zero-filled n x n problem and returns its index
+    size_t add(int n)
+    {
+        dims.push_back(n);
+        cost_offsets.push_back(costs.size());
+        row_offsets.push_back(total_rows);
+        costs.resize(costs.size() + static_cast<size_t>(n) * n, 0.f);
+        total_rows += n;
+        return dims.size() - 1;
+    }
+
+    size_t size() const { return dims.size(); }
+    int dim(size_t k) const { return dims[k]; }
+
+    float* cost(size_t k) { return costs.data() + cost_offsets[k]; }
+    const float* cost(size_t k) const { return costs.data() + cost_offsets[k]; }
+
+    // assignment(k)[i] = j, valid after solve()
+    const long* assignment(size_t k) const { return assignments.data() + row_offsets[k]; }
+
+    // Solves problem k, prepare() must have been called after the last add().
+    // Problems touch disjoint slices so they may be solved concurrently.
+    void solve(size_t k)
+    {
+        const int n = dims[k];
+        if (n == 0)
+            return;
+
+        // Negate: lapjv minimises, we want to maximise.
+        const float* src = costs.data() + cost_offsets[k];
+        float* neg = negated.data() + cost_offsets[k];
+        for (size_t i = 0; i < static_cast<size_t>(n) * n; ++i)
+            neg[i] = -src[i];
+
+        const size_t r = row_offsets[k];
+        lap<false, false>(n, neg, rowsol.data() + r, colsol.data() + r, u.data() + r, v.data() + r);
+
+        for (int i = 0; i < n; ++i)
+            assignments[r + i] = static_cast<long>(rowsol[r + i]);
+    }
+
+    // Sizes the solver scratch for the problems added so far
+    void prepare()
+    {
+        negated.resize(costs.size());
+        rowsol.resize(total_rows);
+        colsol.resize(total_rows);
+        u.resize(total_rows);
+        v.resize(total_rows);
+        assignments.resize(total_rows);
+    }
+
+    // Bytes reserved by problems and solver scratch
+    size_t capacityBytes() const
+    {
+        return dims.capacity() * sizeof(int) + (cost_offsets.capacity() + row_offsets.capacity()) * sizeof(size_t) +
+               (costs.capacity() + negated.capacity() + u.capacity() + v.capacity()) * sizeof(float) +
+               (rowsol.capacity() + colsol.capacity()) * sizeof(int) + assignments.capacity() * sizeof(long);
+    }
+
+    void solve()
+    {
+        prepare();
+        for (size_t k = 0; k < dims.size(); ++k)
+            solve(k);
+    }
+
+private:
+    std::vector<int> dims;
+    std::vector<size_t> cost_offsets;
+    std::vector<size_t> row_offsets;
+    std::vector<float> costs;
+    size_t total_rows = 0;
+
+    // Solver scratch, laid out like costs / rows
+    std::vector<float> negated;
+    std::vector<int> rowsol, colsol;
+    std::vector<float> u, v;
+    std::vector<long> assignments;
+};
+
+} // namespace hungarian
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include <types/detection.hpp>
+#include <io/mapped_file.hpp>
+
+// Binary detection sequence (.motb), native little-endian layout:
+//
+//   BinaryHeader
+//   frame index   uint64[num_frames + 1], frame first_frame + k spans rows [index[k], index[k + 1])
+//   x, y, w, h    float[num_rows] each
+//   confidence    float[num_rows]
+//   class_id      int32[num_rows]
+//   track_id      int32[num_rows]
+//   features      float[num_rows * feature_dim], row-major
+//
+// Every section starts on a BINARY_ALIGNMENT boundary so the columns can be used
+// straight from a memory mapping.
+constexpr char BINARY_MAGIC[4] = {'M', 'O', 'T', 'B'};
+constexpr uint32_t BINARY_VERSION = 1;
+constexpr size_t BINARY_ALIGNMENT = 64;
+
+struct BinaryHeader
+{
+    char magic[4];
+    uint32_t version;
+    int32_t first_frame;
+    int32_t last_frame;
+    uint64_t num_rows;
+    uint32_t feature_dim;
+    uint32_t reserved;
+};
+
+// Zero-copy columns of one frame
+struct BinaryFrame
+{
+    std::span<const float> x, y, w, h;
+    std::span<const float> confidence;
+    std::span<const int32_t> class_id;
+    std::span<const int32_t> track_id;
+    std::span<const float> features; // size() * feature_dim values
+    uint32_t feature_dim = 0;
+
+    size_t size() const { return x.size(); }
+};
+
+class BinaryDetectionFile
+{
+public:
+    explicit BinaryDetectionFile(const std::filesystem::path &path);
+
+    bool empty() const { return header.num_rows == 0; }
+    size_t size() const { return header.num_rows; }
+    int getFirstFrame() const { return header.first_frame; }
+    int getLastFrame() const { return header.last_frame; }
+    uint32_t getFeatureDim() const { return header.feature_dim; }
+
+    // Columns of a frame, empty for frames without rows
+    BinaryFrame getFrame(int frame_id) const;
+
+    // Materialises a frame into tracker input, reusing the capacity of `detections`
+    void readFrame(int frame_id, std::vector<Detection> &detections) const;
+
+private:
+    MappedFile file;
+    BinaryHeader header{};
+
+    const uint64_t *index = nullptr;
+    const float *x = nullptr;
+    const float *y = nullptr;
+    const float *w = nullptr;
+    const float *h = nullptr;
+    const float *confidence = nullptr;
+    const int32_t *class_id = nullptr;
+    const int32_t *track_id = nullptr;
+    const float *features = nullptr;
+};
+
+// Writes detections ordered by frame, as returned by DetectionFile::getDetections().
+// All detections must carry the same number of features (possibly none), unless
+// `features` is given: it then holds `feature_dim` values per detection, in the
+// same order, and replaces Detection::features.
+void writeBinaryDetections(const std::filesystem::path &path,
+                           std::span<const Detection> detections,
+                           std::span<const float> features = {},
+                           size_t feature_dim = 0);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <types/detection.hpp>
+
+// Highest frame id accepted in a file: frames are indexed densely from the first to the
+// last one, so a stray id bounds the index instead of forcing a huge allocation
+constexpr int MAX_FRAME_ID = 10'000'000;
+
+// MOT detection or ground-truth file (frame, id, x, y, w, h, conf[, class, ...]).
+// The file is memory mapped and parsed with std::from_chars in a single pass,
+// then rows are grouped by frame into one contiguous buffer. Grouping is stable,
+// so files that are not sorted by frame are accepted and keep their row order.
+// Frame ids must lie in [1, MAX_FRAME_ID].
+class DetectionFile
+{
+public:
+    explicit DetectionFile(const std::filesystem::path &path);
+
+    bool empty() const { return detections.empty(); }
+    size_t size() const { return detections.size(); }
+    int getFirstFrame() const { return first_frame; }
+    int getLastFrame() const { return last_frame; }
+
+    // All detections, ordered by frame
+    std::span<const Detection> getDetections() const { return detections; }
+
+    // Detections of a frame, empty for frames without rows
+    std::span<Detection> getFrame(int frame_id);
+    std::span<const Detection> getFrame(int frame_id) const;
+
+    // Line order of the detections in the file (blank lines excluded), parallel to
+    // getDetections() / getFrame(). Used to look up row-aligned sidecar data.
+    std::span<const size_t> getRows() const { return rows; }
+    std::span<const size_t> getFrameRows(int frame_id) const;
+
+private:
+    std::vector<Detection> detections{};
+    std::vector<size_t> rows{};
+    std::vector<size_t> offsets{}; // frame f spans [offsets[f - first], offsets[f - first + 1])
+    int first_frame = 0;
+    int last_frame = -1;
+};
+
+// Parses one MOT line (frame, id, x, y, w, h, conf[, class, ...]), values separated by
+// commas and / or whitespace. Returns false for a malformed line.
+bool parseDetection(std::string_view line, Detection &det);
+
+// True for a line with nothing but separators
+bool isBlankLine(std::string_view line);
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+// Sequence of images to draw tracks on, decoded in order
+class FrameSource
+{
+public:
+    virtual ~FrameSource() = default;
+
+    // Decodes the next frame into `image`, reusing its buffer when the decoder allows.
+    // Returns false at the end of the sequence.
+    virtual bool read(cv::Mat &image) = 0;
+
+    virtual int getFrameCount() const = 0; // 0 when unknown
+    virtual double getFrameRate() const = 0; // 0 when unknown
+    virtual cv::Size getFrameSize() const = 0;
+
+    // Sources that can decode any frame independently, and from several threads at once
+    virtual bool isRandomAccess() const { return false; }
+    virtual bool readAt(size_t index, cv::Mat &image) const
+    {
+        (void)index;
+        (void)image;
+        return false;
+    }
+};
+
+// MOT-style folder of images, in file name order
+class ImageFolderSource : public FrameSource
+{
+public:
+    explicit ImageFolderSource(const std::filesystem::path &directory, double t_frame_rate = 0.);
+
+    bool read(cv::Mat &image) override { return readAt(next++, image); }
+    int getFrameCount() const override { return static_cast<int>(files.size()); }
+    double getFrameRate() const override { return frame_rate; }
+    cv::Size getFrameSize() const override { return frame_size; }
+
+    bool isRandomAccess() const override { return true; }
+    bool readAt(size_t index, cv::Mat &image) const override;
+
+private:
+    std::vector<std::filesystem::path> files{};
+    double frame_rate = 0.;
+    cv::Size frame_size{};
+    size_t next = 0;
+};
+
+// Video file or camera through cv::VideoCapture
+class VideoSource : public FrameSource
+{
+public:
+    explicit VideoSource(const std::string &path);
+    explicit VideoSource(int device);
+
+    bool read(cv::Mat &image) override { return capture.read(image); }
+    int getFrameCount() const override;
+    double getFrameRate() const override;
+    cv::Size getFrameSize() const override;
+
+private:
+    mutable cv::VideoCapture capture;
+};
+
+// Detections only, there are no images
+class NullSource : public FrameSource
+{
+public:
+    bool read(cv::Mat &) override { return false; }
+    int getFrameCount() const override { return 0; }
+    double getFrameRate() const override { return 0.; }
+    cv::Size getFrameSize() const override { return {}; }
+};
+
+// Decodes another source ahead on background threads into a bounded pool of frames.
+// read() swaps the decoded frame with the caller's Mat, so buffers circulate between
+// the caller and the pool instead of being reallocated for every frame. Several
+// decoding threads are only used for random access sources.
+class ThreadedFrameSource : public FrameSource
+{
+public:
+    ThreadedFrameSource(std::unique_ptr<FrameSource> t_source, size_t prefetch = 8, size_t num_threads = 1);
+    ~ThreadedFrameSource() override;
+
+    bool read(cv::Mat &image) override;
+    int getFrameCount() const override { return source->getFrameCount(); }
+    double getFrameRate() const override { return source->getFrameRate(); }
+    cv::Size getFrameSize() const override { return source->getFrameSize(); }
+
+private:
+    struct Slot
+    {
+        cv::Mat image{};
+        size_t index = 0;
+        bool ready = false;
+        bool valid = false;
+    };
+
+    std::unique_ptr<FrameSource> source;
+    std::vector<Slot> slots;
+    std::vector<std::thread> workers{};
+
+    std::mutex mutex{};
+    std::condition_variable cv{};
+    size_t next_claim = 0; // next frame a worker decodes
+    size_t next_read = 0;  // next frame handed to the caller
+    bool exhausted = false;
+    bool stopping = false;
+
+    void run();
+};
+
+// Image folder, video file or camera index (e.g. "0")
+std::unique_ptr<FrameSource> openFrameSource(const std::string &path, double frame_rate = 0.);
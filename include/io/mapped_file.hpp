@@ -0,0 +1,25 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+// Read-only memory mapping of a whole file
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::filesystem::path &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    const char *data() const { return static_cast<const char *>(address); }
+    size_t size() const { return length; }
+    std::string_view view() const { return {data(), length}; }
+
+private:
+    void *address = nullptr;
+    size_t length = 0;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include <io/mapped_file.hpp>
+
+// Memory-mapped 2-D float32 NumPy array (.npy, C order, little-endian), e.g. one
+// ReID embedding per row. Rows are served straight from the mapping.
+class NpyArray
+{
+public:
+    explicit NpyArray(const std::filesystem::path &path);
+
+    size_t rows() const { return num_rows; }
+    size_t cols() const { return num_cols; }
+
+    std::span<const float> row(size_t i) const { return {values + i * num_cols, num_cols}; }
+
+private:
+    MappedFile file;
+    const float *values = nullptr;
+    size_t num_rows = 0;
+    size_t num_cols = 0;
+};
+
+// Writes `values` as a (values.size() / cols, cols) float32 array, readable by numpy.load
+void writeNpy(const std::filesystem::path &path, std::span<const float> values, size_t cols);
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <types/detection.hpp>
+
+enum class ResultFormat
+{
+    Text,  // MOT challenge lines: frame,id,x,y,w,h,conf,-1,-1,-1
+    Binary // TrajectoryRow records, see io/trajectory_file.hpp
+};
+
+// Tracking results writer. Rows are formatted with std::to_chars into a large
+// reusable buffer that is handed to write(2) in big chunks, either inline or by
+// a background thread so the tracking loop never waits on the disk.
+class ResultWriter
+{
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+    static constexpr size_t MAX_PENDING_BUFFERS = 2; // full buffers queued before write() blocks
+
+    ResultWriter(const std::filesystem::path &path,
+                 ResultFormat t_format = ResultFormat::Text,
+                 bool background = false,
+                 size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+    // Writes to an already open descriptor (e.g. STDOUT_FILENO), which is not closed
+    ResultWriter(int t_fd,
+                 ResultFormat t_format = ResultFormat::Text,
+                 bool background = false,
+                 size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter &) = delete;
+    ResultWriter &operator=(const ResultWriter &) = delete;
+
+    void write(std::span<const Detection> detections);
+
+    // Text only: terminates a frame with an empty line, as in the streaming protocol
+    void endFrame();
+
+    // Writes everything buffered so far, rethrows background write errors
+    void flush();
+
+private:
+    int fd = -1;
+    bool owns_fd = false;
+    const ResultFormat format;
+    const size_t capacity;
+
+    std::vector<char> buffer{};
+    size_t used = 0;
+
+    // Background writer state
+    std::thread worker{};
+    std::mutex mutex{};
+    std::condition_variable cv{};
+    std::deque<std::vector<char>> pending{};
+    std::vector<std::vector<char>> spare{};
+    bool writing = false;
+    bool stopping = false;
+    std::exception_ptr error = nullptr;
+
+    void start(bool background);
+    void writeHeader();
+    void submit();
+    void writeAll(const char *data, size_t size) const;
+    void run();
+    void rethrow();
+};
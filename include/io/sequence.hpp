@@ -0,0 +1,21 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// [Sequence] section of a MOT challenge seqinfo.ini
+struct SequenceInfo
+{
+    std::string imDir;
+    double frameRate{};
+    int seqLength{};
+    int imWidth{};
+    int imHeight{};
+};
+
+// Missing files and keys are left at their defaults
+SequenceInfo parseSequenceInfo(const std::filesystem::path &iniPath);
+
+// Sequence folders of a dataset split (e.g. data/MOT20/train), sorted by name
+std::vector<std::filesystem::path> listSequences(const std::filesystem::path &splitPath);
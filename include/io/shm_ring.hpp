@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+// Detection as stored in a ring slot
+struct ShmDetection
+{
+    float x, y, w, h;
+    float confidence;
+    int32_t class_id;
+    int32_t track_id; // written back by the tracker
+    int32_t reserved;
+};
+
+// View of one ring slot, pointing straight into shared memory
+struct ShmFrame
+{
+    uint64_t sequence = 0;
+    int32_t frame_id = 0;
+    std::span<ShmDetection> detections{};
+    std::span<float> features{}; // detections.size() * feature_dim values
+    uint32_t feature_dim = 0;
+    uint64_t published_ns = 0; // CLOCK_MONOTONIC, set by publish()
+    uint64_t processed_ns = 0; // CLOCK_MONOTONIC, set by complete()
+};
+
+// Single-producer / single-consumer ring of detection frames in POSIX shared memory,
+// for a detector and a tracker running on the same machine. Every slot holds up to
+// max_detections detections and their embeddings. A slot goes through three steps:
+//
+//   producer: tryAcquire() -> fill in place -> publish()
+//   consumer: tryReceive() -> track, write track ids into the slot -> complete()
+//   producer: tryCollect() -> read track ids, the slot is free again
+//
+// The three positions are lock-free 64-bit counters in the shared header, so neither
+// side ever blocks the other. Nothing is copied between the processes.
+class ShmRing
+{
+public:
+    static constexpr char MAGIC[4] = {'M', 'O', 'T', 'R'};
+    static constexpr uint32_t VERSION = 1;
+
+    // Producer side: creates (or replaces) the segment, removed again on destruction
+    static ShmRing create(const std::string &name, uint32_t num_slots, uint32_t max_detections, uint32_t feature_dim);
+
+    // Consumer side: attaches to an existing segment, throws if it does not exist yet
+    static ShmRing open(const std::string &name);
+    // Same, but empty while the producer is still initialising the segment. Throws
+    // std::system_error when it does not exist, std::runtime_error when it is not a ring.
+    static std::optional<ShmRing> tryOpen(const std::string &name);
+
+    ShmRing(ShmRing &&other) noexcept;
+    ShmRing &operator=(ShmRing &&other) noexcept;
+    ShmRing(const ShmRing &) = delete;
+    ShmRing &operator=(const ShmRing &) = delete;
+    ~ShmRing();
+
+    uint32_t getNumSlots() const;
+    uint32_t getMaxDetections() const;
+    uint32_t getFeatureDim() const;
+
+    // Producer: next free slot, sized for max_detections
+    bool tryAcquire(ShmFrame &frame);
+    // Producer: hands the first `count` detections of the acquired slot to the consumer
+    void publish(ShmFrame &frame, size_t count);
+    // Producer: oldest completed slot, valid until that slot is acquired again
+    bool tryCollect(ShmFrame &frame);
+    // Producer: no more frames will be published
+    void close();
+
+    // Consumer: oldest published slot not received yet
+    bool tryReceive(ShmFrame &frame);
+    // Consumer: track ids are written, results become visible to the producer
+    void complete(ShmFrame &frame);
+    // Consumer: the producer closed the ring and every frame was received
+    bool finished() const;
+
+    static uint64_t now();
+
+private:
+    struct Header;
+
+    ShmRing() = default;
+
+    std::string name{};
+    bool owner = false;
+    void *address = nullptr;
+    size_t length = 0;
+    uint64_t received = 0; // consumer-local position
+
+    Header *header() const { return static_cast<Header *>(address); }
+    char *slotBase(uint64_t sequence) const;
+    // View of a slot, with its published detections or, for the producer, all of them
+    ShmFrame slot(uint64_t sequence, bool published) const;
+    void release();
+};
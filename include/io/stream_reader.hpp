@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <types/detection.hpp>
+
+// Non-blocking reader of the streaming detection protocol: MOT detection lines,
+// each frame terminated by an empty line. Input is buffered as it arrives and
+// split into complete frames, stamped with the time their first line was read.
+class StreamReader
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame
+    {
+        std::vector<Detection> detections{};
+        Clock::time_point received{};
+    };
+
+    // Switches `fd` to non-blocking mode until destruction, the descriptor is not closed.
+    // The flag lives on the open file description, shared with a tty's stdout and the shell.
+    explicit StreamReader(int t_fd);
+    ~StreamReader();
+
+    StreamReader(const StreamReader &) = delete;
+    StreamReader &operator=(const StreamReader &) = delete;
+
+    // Waits up to `timeout_ms` (-1 for ever) for input and reads everything available.
+    // Returns false once the peer has closed the stream.
+    bool poll(int timeout_ms);
+
+    // Pops the next complete frame, a frame still missing its empty line is only
+    // returned after the stream was closed
+    bool nextFrame(Frame &frame);
+
+    bool closed() const { return eof; }
+    size_t getSkippedLines() const { return skipped_lines; }
+
+private:
+    int fd;
+    int original_flags = 0;
+    bool eof = false;
+    std::string buffer{};
+    size_t parsed = 0; // bytes of buffer already split into lines
+    Frame current{};
+    bool in_frame = false;
+    std::deque<Frame> ready{};
+    size_t skipped_lines = 0;
+
+    void split(Clock::time_point now);
+};
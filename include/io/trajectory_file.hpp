@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include <io/mapped_file.hpp>
+
+// Binary trajectory output (.mott), native little-endian layout:
+//
+//   TrajectoryHeader
+//   TrajectoryRow[...] in the order they were written
+//
+// Rows are fixed-size so the file can be appended to while tracking and read
+// back as a single span from a memory mapping.
+constexpr char TRAJECTORY_MAGIC[4] = {'M', 'O', 'T', 'T'};
+constexpr uint32_t TRAJECTORY_VERSION = 1;
+
+struct TrajectoryHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t row_size;
+    uint32_t reserved;
+};
+
+struct TrajectoryRow
+{
+    int32_t frame_id;
+    int32_t track_id;
+    int32_t class_id;
+    float x, y, w, h;
+    float confidence;
+};
+
+class TrajectoryFile
+{
+public:
+    explicit TrajectoryFile(const std::filesystem::path &path);
+
+    std::span<const TrajectoryRow> getRows() const { return rows; }
+
+private:
+    MappedFile file;
+    std::span<const TrajectoryRow> rows{};
+};
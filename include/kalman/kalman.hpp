@@ -29,6 +29,18 @@ public:
 
     cv::Rect2f predict() { return getBox(kf.predict()); };
 
+    // Filter object and matrix data, subclasses hold no state of their own
+    size_t getMemoryBytes() const
+    {
+        size_t bytes = sizeof(*this);
+        for (const cv::Mat *mat : {&kf.statePre, &kf.statePost, &kf.transitionMatrix, &kf.controlMatrix,
+                                   &kf.measurementMatrix, &kf.processNoiseCov, &kf.measurementNoiseCov,
+                                   &kf.errorCovPre, &kf.gain, &kf.errorCovPost, &kf.temp1, &kf.temp2,
+                                   &kf.temp3, &kf.temp4, &kf.temp5, &measurement})
+            bytes += mat->total() * mat->elemSize();
+        return bytes;
+    }
+
 protected:
     float time_step;
     float process_noise_scale;
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include <types/detection.hpp>
+
+class ThreadPool;
+
+// HOTA localisation thresholds 0.05, 0.10, ..., 0.95
+inline constexpr size_t HOTA_THRESHOLDS = 19;
+
+struct MetricsConfig
+{
+    float iou_threshold = 0.5f;    // CLEAR-MOT and identity matching
+    float min_gt_confidence = 1.f; // ground-truth rows below are ignored (MOT "consider" flag)
+};
+
+// Raw counts of one or more sequences. Counts add up, so the metrics of a whole split
+// are the ratios of the summed counts, like the motmetrics OVERALL row and the
+// TrackEval COMBINED row.
+struct MotMetrics
+{
+    int frames = 0;
+    int gt_tracks = 0;
+    size_t gt_detections = 0;
+    size_t hyp_detections = 0;
+
+    // CLEAR-MOT, matches include identity switches
+    size_t matches = 0;
+    size_t switches = 0;
+    size_t misses = 0;
+    size_t false_positives = 0;
+    size_t fragmentations = 0;
+    double distance = 0.; // sum of 1 - IoU over matches
+    int mostly_tracked = 0;
+    int partially_tracked = 0;
+    int mostly_lost = 0;
+
+    // Identity, true positives of the best one-to-one id mapping
+    size_t idtp = 0;
+
+    // HOTA per threshold: true positives, association sums weighted by true positives
+    // (Jaccard, recall, precision) and the summed similarity of true positives
+    std::array<double, HOTA_THRESHOLDS> hota_tp{};
+    std::array<double, HOTA_THRESHOLDS> hota_ass{};
+    std::array<double, HOTA_THRESHOLDS> hota_ass_re{};
+    std::array<double, HOTA_THRESHOLDS> hota_ass_pr{};
+    std::array<double, HOTA_THRESHOLDS> hota_loc{};
+
+    MotMetrics &operator+=(const MotMetrics &other);
+
+    double mota() const;
+    double motp() const; // mean 1 - IoU of matches, lower is better, as reported by motmetrics
+    double recall() const;
+    double precision() const;
+
+    double idf1() const;
+    double idp() const;
+    double idr() const;
+
+    // Averaged over the HOTA thresholds
+    double hota() const;
+    double deta() const;
+    double assa() const;
+    double loca() const;
+    double detre() const;
+    double detpr() const;
+    double assre() const;
+    double asspr() const;
+};
+
+// Evaluates the tracks `hyp` against the ground truth `gt` of one sequence. Track ids are
+// read from Detection::track_id, rows do not need to be sorted by frame.
+// CLEAR-MOT and IDF1 follow motmetrics (eval_motchallenge), HOTA follows TrackEval
+// without distractor removal. HOTA thresholds run on `pool` when given.
+MotMetrics evaluateMot(std::span<const Detection> gt, std::span<const Detection> hyp,
+                       const MetricsConfig &config = {}, ThreadPool *pool = nullptr);
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <vector>
+
+// Bounded lock-free single-producer / single-consumer ring buffer.
+// One thread pushes and one thread pops. The blocking variants sleep on the
+// indices with std::atomic::wait, so a stalled stage does not spin a core.
+template <typename T>
+class SpscQueue
+{
+public:
+    // The capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity) : slots(std::bit_ceil(capacity < 1 ? size_t{1} : capacity)), mask(slots.size() - 1) {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    size_t capacity() const { return slots.size(); }
+
+    bool tryPush(T &value)
+    {
+        size_t tail = tail_index.load(std::memory_order_relaxed);
+        if (tail - head_index.load(std::memory_order_acquire) == slots.size())
+            return false;
+
+        slots[tail & mask] = std::move(value);
+        tail_index.store(tail + 1, std::memory_order_release);
+        tail_index.notify_one();
+        return true;
+    }
+
+    std::optional<T> tryPop()
+    {
+        size_t head = head_index.load(std::memory_order_relaxed);
+        if (head == tail_index.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        std::optional<T> value(std::move(slots[head & mask]));
+        head_index.store(head + 1, std::memory_order_release);
+        head_index.notify_one();
+        return value;
+    }
+
+    // Blocks while the queue is full
+    void push(T value)
+    {
+        while (!tryPush(value))
+        {
+            size_t head = head_index.load(std::memory_order_acquire);
+            if (tail_index.load(std::memory_order_relaxed) - head == slots.size())
+                head_index.wait(head, std::memory_order_acquire);
+        }
+    }
+
+    // Blocks while the queue is empty
+    T pop()
+    {
+        while (true)
+        {
+            if (auto value = tryPop())
+                return std::move(*value);
+
+            size_t tail = tail_index.load(std::memory_order_acquire);
+            if (tail == head_index.load(std::memory_order_relaxed))
+                tail_index.wait(tail, std::memory_order_acquire);
+        }
+    }
+
+private:
+    std::vector<T> slots;
+    const size_t mask;
+
+    // Producer and consumer indices live on separate cache lines
+    alignas(64) std::atomic<size_t> tail_index{0};
+    alignas(64) std::atomic<size_t> head_index{0};
+};
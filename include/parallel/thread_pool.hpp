@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed-size work-stealing thread pool.
+// Each worker owns a task deque: it pops from the front of its own deque and,
+// when empty, steals from the back of the others. Tasks submitted from a worker
+// go to that worker's deque, external submissions are spread round-robin.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    template <typename F>
+    auto submit(F &&fn) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+    {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(fn));
+        auto result = task->get_future();
+        push([task]()
+             { (*task)(); });
+        return result;
+    }
+
+    // Runs fn(i) for every i in [begin, end), split into chunks of at least `grain` indices.
+    // The calling thread executes chunks too, so it is safe to call from inside a pool task.
+    void parallelFor(size_t begin, size_t end, const std::function<void(size_t)> &fn, size_t grain = 1);
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void push(std::function<void()> task);
+    bool pop(size_t index, std::function<void()> &task);
+    void run(size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> next_queue{0};
+    bool stop = false;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <types/detection.hpp>
+
+enum class MotionModel
+{
+    ConstantVelocity, // straight lines, bouncing off the canvas borders
+    RandomWalk        // velocity perturbed by `motion_noise` every frame
+};
+
+struct CrowdConfig
+{
+    size_t num_objects = 100;
+    float density = 7e-5f; // objects per square pixel (MOT20 is about 7e-5), sets the canvas size
+    float aspect_ratio = 16.f / 9.f;
+
+    MotionModel motion = MotionModel::ConstantVelocity;
+    float speed = 2.f;        // mean pixels per frame
+    float motion_noise = 0.3f; // random walk, pixels per frame squared
+
+    float min_height = 40.f; // boxes are 0.4 times as wide as they are high
+    float max_height = 160.f;
+    float box_noise = 1.f; // detection jitter, pixels
+
+    float occlusion_rate = 0.f;    // fraction of frames an object is hidden
+    float occlusion_length = 10.f; // mean length of an occlusion, frames
+    float miss_rate = 0.f;         // visible objects left undetected
+    float false_positive_rate = 0.f; // false positives per frame, as a fraction of num_objects
+
+    size_t feature_dim = 0;          // 0 disables embeddings
+    float identity_separation = 1.f; // 1 draws identities independently, 0 makes them identical
+    float feature_noise = 0.1f;      // per-detection embedding noise
+
+    uint32_t seed = 0;
+};
+
+// Deterministic stream of crowd detections with ground truth. Random numbers come from
+// splitmix64 without the standard distributions, so a seed gives the same generator
+// sequence with every standard library. The floats derived from it go through libm and
+// may differ in the last bits between platforms.
+class CrowdGenerator
+{
+public:
+    explicit CrowdGenerator(const CrowdConfig &t_config);
+
+    // Advances one frame. Detections hold visible, detected objects followed by false
+    // positives. Ground truth holds every object (track_id = object index + 1), occluded ones included.
+    void next(std::vector<Detection> &detections);
+    void next(std::vector<Detection> &detections, std::vector<Detection> &ground_truth);
+
+    const CrowdConfig &getConfig() const { return config; }
+    int getFrame() const { return frame; }
+    float getWidth() const { return width; }
+    float getHeight() const { return height; }
+
+    // State of the current frame, by object index
+    std::vector<cv::Rect2f> getBoxes() const;
+    bool isVisible(size_t object) const { return objects[object].occluded == 0; }
+
+private:
+    struct Object
+    {
+        cv::Rect2f box;
+        float vx = 0.f;
+        float vy = 0.f;
+        uint8_t occluded = 0;
+        std::vector<float> identity{};
+    };
+
+    const CrowdConfig config;
+    std::vector<Object> objects{};
+    float width = 0.f;
+    float height = 0.f;
+    int frame = 0;
+    double false_positive_budget = 0.;
+
+    uint64_t state; // splitmix64
+
+    float uniform();
+    float uniform(float low, float high) { return low + (high - low) * uniform(); }
+    float normal();
+    void randomUnit(std::vector<float> &vector);
+    void embed(const std::vector<float> &identity, std::vector<float> &features);
+    void move(Object &object);
+    void step(std::vector<Detection> &detections, std::vector<Detection> *ground_truth);
+};
+
+// Writes `frames` frames as a MOT sequence folder: seqinfo.ini, det/det.txt, gt/gt.txt
+// (with visibility) and det/det.npy when the config has embeddings
+void writeCrowdSequence(const CrowdConfig &config, const std::filesystem::path &path, int frames);
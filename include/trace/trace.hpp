@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Scoped event recording, written as Chrome trace-event JSON (open it in
+// https://ui.perfetto.dev or chrome://tracing). Every thread appends to its own
+// buffer without locks; buffers outlive their threads until clear().
+//
+//     trace::start();
+//     { trace::Scope scope("update", "tracker"); ... }
+//     trace::write("trace.json");
+//
+// Names and categories are not copied: pass string literals.
+namespace trace
+{
+    struct Event
+    {
+        const char *name;
+        const char *category;
+        uint64_t start_ns; // since start()
+        uint64_t duration_ns;
+    };
+
+    namespace detail
+    {
+        extern std::atomic<bool> recording;
+        uint64_t now();
+        void append(const Event &event);
+    }
+
+    // Starts recording, at most `max_events` per thread (later events are dropped)
+    void start(size_t max_events = size_t(1) << 22);
+    void stop();
+    inline bool enabled() { return detail::recording.load(std::memory_order_relaxed); }
+
+    // Drops every recorded event, call it while no thread is recording
+    void clear();
+
+    // Name of the calling thread in the trace
+    void setThreadName(const std::string &name);
+
+    // Events recorded so far and events dropped over the limit
+    size_t size();
+    size_t dropped();
+
+    // Writes the events of every thread, throws std::runtime_error if the file cannot be written
+    void write(const std::filesystem::path &path);
+
+    // Escapes quotes and backslashes and drops control characters, for a JSON string value.
+    // Also used by the tools that write JSON reports.
+    std::string escape(const std::string &text);
+
+    // Records its lifetime as a complete event when recording. Building with
+    // MOT_NO_PROFILING removes it.
+    class Scope
+    {
+    public:
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+#ifdef MOT_NO_PROFILING
+        Scope(const char *, const char * = "mot") {}
+        ~Scope() {} // user-provided, so unused scopes do not warn
+#else
+        Scope(const char *t_name, const char *t_category = "mot") : name(t_name), category(t_category)
+        {
+            if (enabled()) [[unlikely]]
+                start_ns = detail::now();
+        }
+
+        ~Scope()
+        {
+            if (start_ns != NOT_RECORDING) [[unlikely]]
+                detail::append(Event{name, category, start_ns, detail::now() - start_ns});
+        }
+
+    private:
+        static constexpr uint64_t NOT_RECORDING = UINT64_MAX;
+
+        const char *name;
+        const char *category;
+        uint64_t start_ns = NOT_RECORDING;
+#endif
+    };
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "sort.hpp"
+#include <assignment/affinity.hpp>
+#include <assignment/batch.hpp>
+
+// Runs many independent SORT streams with their association stage batched.
+// Each stream keeps its own Sort state, but the boxes of all streams are packed
+// into shared SoA buffers, every cost block is built by the same IoU kernel and
+// all LAP problems are solved from one packed batch. This amortises per-call
+// overhead when many low-density streams share a process.
+class SortBatch
+{
+public:
+    SortBatch(const SortConfig &config, size_t num_streams);
+
+    size_t size() const { return trackers.size(); }
+    const Sort &getTracker(size_t stream) const { return *trackers.at(stream); }
+
+    // Set on every stream. The batched cost and solve stages are timed once per frame.
+    void setProfiler(std::shared_ptr<TrackerProfiler> t_profiler);
+
+    // Sum of the streams, the packed buffers count as scratch
+    MemoryReport getMemoryReport() const;
+
+    // detections[s] holds the current frame of stream s
+    void update(std::vector<std::vector<Detection>> &detections);
+
+private:
+    static constexpr size_t NO_PROBLEM = static_cast<size_t>(-1);
+
+    std::vector<std::unique_ptr<Sort>> trackers{};
+    std::shared_ptr<TrackerProfiler> profiler = nullptr;
+
+    // Scratch kept across frames
+    affinity::Boxes det_boxes{};
+    affinity::Boxes track_boxes{};
+    std::vector<size_t> det_offsets{};
+    std::vector<size_t> track_offsets{};
+    std::vector<size_t> problems{};
+    hungarian::AssignmentBatch batch{};
+};
@@ -11,6 +11,7 @@ struct BotSortTrack : BaseTrack
     BotSortTrack(const cv::Rect2f &rect, const std::vector<float> &feat, const KalmanConfig &config);
     void predict() override;
     void update(Detection &det) override;
+    void addMemory(MemoryReport &report) const override;
 };
 
 struct BotSortConfig
@@ -31,12 +32,19 @@ struct BotSortConfig
 
     float proximity_thresh = 0.5f;
     float appearance_thresh = 0.9f;
+
+    bool class_aware = false;
+    size_t num_threads = 1;
 };
 
 class BotSort : public BaseTracker
 {
 public:
-    BotSort(const BotSortConfig &t_config) : config(t_config) {}
+    BotSort(const BotSortConfig &t_config) : config(t_config)
+    {
+        if (config.num_threads > 1)
+            setThreadPool(std::make_shared<ThreadPool>(config.num_threads));
+    }
     const BotSortConfig &getConfig() const { return config; };
     void update(std::vector<Detection> &detections) override;
 
@@ -50,4 +58,15 @@ private:
                 std::set<std::pair<size_t, size_t>> &matches,
                 std::set<size_t> &unmatched_detections,
                 std::set<size_t> &unmatched_tracks);
+    void associate(std::vector<Detection *> &dets,
+                   std::vector<BotSortTrack *> &trks,
+                   float match_thresh,
+                   float proximity_thresh,
+                   float appearance_thresh,
+                   std::set<std::pair<size_t, size_t>> &matches,
+                   std::set<size_t> &unmatched_detections,
+                   std::set<size_t> &unmatched_tracks);
+    void updateMatches(const std::set<std::pair<size_t, size_t>> &matches,
+                       std::vector<Detection *> &dets,
+                       std::vector<BotSortTrack *> &trks);
 };
\ No newline at end of file
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <fstream>
+#include <sstream>
 #include <rfl/toml.hpp>
 
 #include "tracker.hpp"
 #include "sort.hpp"
 #include "botsort.hpp"
+#include "tiled.hpp"
 
 enum class TrackerType
 {
@@ -49,11 +51,44 @@ class TrackerFactory
 {
     using TrackerConfig = rfl::TaggedUnion<"tracker", SortConfig, BotSortConfig>;
 
+    // Optional [tiling] table next to the tracker config
+    struct TilingSection
+    {
+        TilingConfig tiling{};
+    };
+
 public:
     static std::unique_ptr<BaseTracker> create(const std::string &config_file)
     {
         std::ifstream file(config_file);
-        auto result = rfl::toml::read<TrackerConfig, rfl::DefaultIfMissing>(file);
+        if (!file.is_open())
+            throw std::runtime_error("Could not open config file: " + config_file);
+
+        std::stringstream content;
+        content << file.rdbuf();
+        return createFromString(content.str());
+    }
+
+    static std::unique_ptr<BaseTracker> createFromString(const std::string &toml)
+    {
+        std::istringstream stream(toml);
+        auto section = rfl::toml::read<TilingSection, rfl::DefaultIfMissing>(stream);
+        if (!section.has_value())
+            throw std::runtime_error(section.error().what());
+
+        const auto &tiling = section.value().tiling;
+        if (tiling.tile_width > 0.f && tiling.tile_height > 0.f)
+            return std::make_unique<TiledTracker>(tiling, [toml]()
+                                                  { return createTracker(toml); });
+
+        return createTracker(toml);
+    }
+
+private:
+    static std::unique_ptr<BaseTracker> createTracker(const std::string &toml)
+    {
+        std::istringstream stream(toml);
+        auto result = rfl::toml::read<TrackerConfig, rfl::DefaultIfMissing>(stream);
         if (!result.has_value())
             throw std::runtime_error(result.error().what());
 
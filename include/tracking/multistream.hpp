@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <future>
+#include <mutex>
+
+#include "tracker.hpp"
+#include <parallel/thread_pool.hpp>
+
+struct StreamStats
+{
+    size_t frames = 0;
+    double mean_latency_ms = 0.; // submit to result, including queueing
+    double max_latency_ms = 0.;
+    double last_latency_ms = 0.;
+    double mean_update_ms = 0.;  // time spent inside the tracker update
+};
+
+// Owns one tracker per stream and schedules their updates on a shared work-stealing pool.
+// Frames of a given stream are always processed one at a time, in submission order.
+class MultiStreamTracker
+{
+    using Clock = std::chrono::steady_clock;
+
+public:
+    MultiStreamTracker(const std::string &config_file,
+                       size_t num_streams,
+                       size_t num_threads = std::thread::hardware_concurrency());
+    MultiStreamTracker(std::vector<std::unique_ptr<BaseTracker>> trackers,
+                       size_t num_threads = std::thread::hardware_concurrency());
+    ~MultiStreamTracker();
+
+    size_t size() const { return streams.size(); }
+    ThreadPool &getPool() { return pool; }
+
+    // Queues a frame of detections for `stream`; the future yields them back with track ids assigned
+    std::future<std::vector<Detection>> submit(size_t stream, std::vector<Detection> detections);
+
+    // Blocks until every submitted frame has been processed
+    void wait();
+
+    StreamStats getStats(size_t stream) const;
+    const BaseTracker &getTracker(size_t stream) const { return *streams.at(stream)->tracker; }
+
+private:
+    struct Job
+    {
+        std::vector<Detection> detections;
+        std::promise<std::vector<Detection>> result;
+        Clock::time_point submitted;
+    };
+
+    struct Stream
+    {
+        std::unique_ptr<BaseTracker> tracker;
+        mutable std::mutex mutex;
+        std::deque<Job> jobs{};
+        bool scheduled = false;
+        StreamStats stats{};
+        double total_latency_ms = 0.;
+        double total_update_ms = 0.;
+    };
+
+    void process(Stream &stream);
+
+    std::vector<std::unique_ptr<Stream>> streams{};
+
+    std::mutex mutex;
+    std::condition_variable idle;
+    size_t in_flight = 0;
+
+    // Declared last: workers are joined before the streams they reference are destroyed
+    ThreadPool pool;
+};
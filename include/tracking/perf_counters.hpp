@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+constexpr size_t NUM_PERF_COUNTERS = 4;
+
+// Counter values, in the order of the events opened
+using PerfValues = std::array<uint64_t, NUM_PERF_COUNTERS>;
+
+// perf_event_attr type and config of a counter
+struct PerfEvent
+{
+    uint32_t type;
+    uint64_t config;
+};
+
+// Group of perf_event_open counters of the calling thread, user space only, read together.
+// Linux only: construction throws std::system_error elsewhere, when the kernel or the
+// container denies access (perf_event_paranoid, seccomp) or the CPU exposes no PMU (many VMs).
+class PerfCounters
+{
+public:
+    // Cycles, instructions, last-level cache misses, branch misses
+    static const std::array<PerfEvent, NUM_PERF_COUNTERS> HARDWARE;
+
+    explicit PerfCounters(std::span<const PerfEvent, NUM_PERF_COUNTERS> events = HARDWARE);
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    // Counts since construction, on the thread that constructed it. Scaled up by
+    // enabled / running time when the kernel multiplexes the group with other perf users.
+    PerfValues read() const;
+
+    // Whether the group has been on the PMU at all. It opens fine but never runs, and reads
+    // 0, when the counters are held by the NMI watchdog or another perf user, or on some VMs.
+    bool scheduled() const;
+
+private:
+    // PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING layout
+    struct Group
+    {
+        uint64_t count;
+        uint64_t time_enabled;
+        uint64_t time_running;
+        uint64_t values[NUM_PERF_COUNTERS];
+    };
+
+    Group readGroup() const;
+
+    std::array<int, NUM_PERF_COUNTERS> fds{-1, -1, -1, -1};
+};
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <trace/trace.hpp>
+#include <tracking/perf_counters.hpp>
+
+// Stages of a tracker update. Associations report their cost matrix build and LAP
+// solve separately, BotSort's three passes add up in the same stages.
+enum class TrackerStage : int
+{
+    Predict = 0,
+    Cost,
+    Solve,
+    Update,
+    Create,
+    Prune,
+    Count
+};
+
+constexpr size_t NUM_TRACKER_STAGES = static_cast<size_t>(TrackerStage::Count);
+
+constexpr const char *stageName(TrackerStage stage)
+{
+    switch (stage)
+    {
+    case TrackerStage::Predict:
+        return "predict";
+    case TrackerStage::Cost:
+        return "cost";
+    case TrackerStage::Solve:
+        return "solve";
+    case TrackerStage::Update:
+        return "update";
+    case TrackerStage::Create:
+        return "create";
+    case TrackerStage::Prune:
+        return "prune";
+    default:
+        return "unknown";
+    }
+}
+
+// Lock-free latency histogram: exact below 8 ns, then 4 log-spaced buckets per power of
+// two (quantiles within 25%) up to about 8.6 s. The maximum is exact.
+class LatencyHistogram
+{
+public:
+    static constexpr size_t SUB_BUCKETS = 4;
+    static constexpr size_t NUM_BUCKETS = 32 * SUB_BUCKETS;
+
+    void record(uint64_t ns);
+    void reset();
+
+    uint64_t count() const { return total_count.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_ns.load(std::memory_order_relaxed); }
+    double mean() const;
+    // Upper bound of the bucket holding quantile q (0 to 1), in ns
+    double quantile(double q) const;
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets{};
+    std::atomic<uint64_t> total_count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+
+    static size_t bucketOf(uint64_t ns);
+    static double upperBound(size_t bucket);
+};
+
+struct StageStats
+{
+    uint64_t count = 0;
+    double mean_us = 0.;
+    double p50_us = 0.;
+    double p99_us = 0.;
+    double max_us = 0.;
+
+    // Cost and Solve only: matrices seen, rows x cols
+    uint64_t matrices = 0;
+    double mean_cells = 0.;
+    uint64_t max_rows = 0;
+    uint64_t max_cols = 0;
+
+    // With hardware counters: means per call, on the thread running the stage
+    bool has_counters = false;
+    double cycles = 0.;
+    double instructions = 0.;
+    double cache_misses = 0.;
+    double branch_misses = 0.;
+
+    double ipc() const { return cycles > 0. ? instructions / cycles : 0.; }
+};
+
+// Tracks of the last profiled update, by state
+struct TrackCounts
+{
+    uint64_t frames = 0;
+    uint64_t tracked = 0;
+    uint64_t lost = 0;
+    uint64_t unconfirmed = 0; // TrackState::New
+    uint64_t max_total = 0;   // largest track list seen
+};
+
+// Collects per-stage latencies, matrix sizes and track counts of the trackers it is set on
+// (BaseTracker::setProfiler). Recording is lock-free, so a profiler can be shared by
+// trackers on different threads and by association partitions solved on a pool.
+class TrackerProfiler
+{
+public:
+    void record(TrackerStage stage, uint64_t ns);
+    void recordMatrix(TrackerStage stage, size_t rows, size_t cols);
+    void recordTracks(uint64_t tracked, uint64_t lost, uint64_t unconfirmed);
+    void reset();
+
+    // Reads cycles, instructions, cache and branch misses around every stage. Work a stage
+    // hands to a pool is not counted, profile with num_threads = 1 for complete counts.
+    // Returns false, with the reason in getCounterError(), when counters are unavailable.
+    // Call it before the profiler is set on a tracker.
+    bool enableCounters(std::span<const PerfEvent, NUM_PERF_COUNTERS> events = PerfCounters::HARDWARE);
+    bool hasCounters() const { return counters_enabled.load(std::memory_order_relaxed); }
+    const std::string &getCounterError() const { return counter_error; }
+
+    // Counters of the calling thread, false if they cannot be opened on it
+    bool readCounters(PerfValues &values) const;
+    void recordCounters(TrackerStage stage, const PerfValues &begin, const PerfValues &end);
+
+    StageStats getStats(TrackerStage stage) const;
+    TrackCounts getTrackCounts() const;
+    const LatencyHistogram &getHistogram(TrackerStage stage) const { return stages[static_cast<size_t>(stage)].latency; }
+
+private:
+    struct Stage
+    {
+        LatencyHistogram latency{};
+        std::atomic<uint64_t> matrices{0};
+        std::atomic<uint64_t> cells{0};
+        std::atomic<uint64_t> max_rows{0};
+        std::atomic<uint64_t> max_cols{0};
+        std::atomic<uint64_t> counted{0};
+        std::array<std::atomic<uint64_t>, NUM_PERF_COUNTERS> counters{};
+    };
+
+    std::array<Stage, NUM_TRACKER_STAGES> stages{};
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> tracked{0};
+    std::atomic<uint64_t> lost{0};
+    std::atomic<uint64_t> unconfirmed{0};
+    std::atomic<uint64_t> max_tracks{0};
+
+    std::atomic<bool> counters_enabled{false};
+    std::array<PerfEvent, NUM_PERF_COUNTERS> counter_events{};
+    std::string counter_error{};
+};
+
+// Times a scope into a profiler, with hardware counters when enabled, and records it as a
+// trace event while tracing. Otherwise it only tests a null pointer and a flag, and
+// building with MOT_NO_PROFILING removes it.
+class StageTimer
+{
+public:
+    StageTimer(const StageTimer &) = delete;
+    StageTimer &operator=(const StageTimer &) = delete;
+
+#ifdef MOT_NO_PROFILING
+    StageTimer(TrackerProfiler *, TrackerStage) {}
+    ~StageTimer() {} // user-provided, so unused timers do not warn
+#else
+    StageTimer(TrackerProfiler *t_profiler, TrackerStage t_stage)
+        : profiler(t_profiler), stage(t_stage), scope(stageName(t_stage), "tracker")
+    {
+        if (profiler) [[unlikely]]
+        {
+            counting = profiler->hasCounters() && profiler->readCounters(counters);
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~StageTimer()
+    {
+        if (profiler) [[unlikely]]
+        {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            profiler->record(stage, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+
+            PerfValues end;
+            if (counting && profiler->readCounters(end))
+                profiler->recordCounters(stage, counters, end);
+        }
+    }
+
+private:
+    TrackerProfiler *profiler;
+    TrackerStage stage;
+    trace::Scope scope;
+    std::chrono::steady_clock::time_point start{};
+    bool counting = false;
+    PerfValues counters{};
+#endif
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <io/mapped_file.hpp>
+#include "tracker.hpp"
+
+// Recording of tracker updates (.motr), native little-endian layout:
+//
+//   RecordingHeader
+//   then per update():
+//     UpdateHeader
+//     RecordedRow[num_detections]   input detections
+//     float[num_features]           their embeddings, concatenated in row order
+//     int32[num_detections]         track ids emitted by the update
+//
+// Records are appended as updates complete, so a recording cut short by a crash
+// is readable up to its last complete update.
+constexpr char RECORDING_MAGIC[4] = {'M', 'O', 'T', 'R'};
+constexpr uint32_t RECORDING_VERSION = 1;
+
+struct RecordingHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t reserved;
+};
+
+struct UpdateHeader
+{
+    uint64_t timestamp_ns; // update start, since the recording started
+    uint64_t update_ns;    // time spent in update()
+    uint32_t num_detections;
+    uint32_t num_features;
+};
+
+struct RecordedRow
+{
+    int32_t frame_id;
+    int32_t class_id;
+    float confidence;
+    float x, y, w, h;
+    uint32_t feature_dim;
+};
+
+struct RecordedUpdate
+{
+    uint64_t timestamp_ns = 0;
+    uint64_t update_ns = 0;
+    std::vector<Detection> detections{}; // input, track_id left at -1
+    std::vector<int> track_ids{};        // output, one per detection
+};
+
+// Wraps any tracker and appends each update(), inputs and emitted ids, to a recording.
+// Tracks and the memory report are those of the wrapped tracker.
+class RecordingTracker : public BaseTracker
+{
+    using Clock = std::chrono::steady_clock;
+
+public:
+    RecordingTracker(std::unique_ptr<BaseTracker> t_tracker, const std::filesystem::path &path);
+
+    void update(std::vector<Detection> &detections) override;
+    const std::vector<std::unique_ptr<BaseTrack>> &getTracks() const override { return tracker->getTracks(); }
+    MemoryReport getMemoryReport() const override { return tracker->getMemoryReport(); }
+
+    BaseTracker &getTracker() { return *tracker; }
+    size_t size() const { return num_updates; }
+    void flush();
+
+private:
+    std::unique_ptr<BaseTracker> tracker;
+    std::ofstream file;
+    Clock::time_point start;
+    size_t num_updates = 0;
+    std::vector<char> buffer{}; // one record, reused across updates
+};
+
+// Sequential reader of a recording
+class RecordingReader
+{
+public:
+    explicit RecordingReader(const std::filesystem::path &path);
+
+    // Next complete update, false at the end of the recording
+    bool next(RecordedUpdate &update);
+
+    // The recording ends with an incomplete update, e.g. the recorder was killed
+    bool truncated() const { return is_truncated; }
+
+private:
+    MappedFile file;
+    size_t offset = sizeof(RecordingHeader);
+    bool is_truncated = false;
+};
+
+struct ReplayOptions
+{
+    bool realtime = false; // wait for the recorded timestamps instead of replaying back to back
+};
+
+struct ReplayResult
+{
+    size_t updates = 0;
+    size_t detections = 0;
+    size_t mismatched_updates = 0;
+    size_t mismatched_ids = 0;
+    long first_mismatch = -1; // index of the first update whose ids differ
+    bool truncated = false;
+    std::vector<double> recorded_ms{}; // update() latency per update, as recorded
+    std::vector<double> replayed_ms{}; // and as replayed
+
+    bool identical() const { return mismatched_ids == 0; }
+};
+
+// Drives `tracker`, normally a fresh one, through a recording and compares its ids with the
+// recorded ones. Ids are unique per process so they are matched up to a renaming: a recorded
+// id must always map to the same replayed id and vice versa.
+ReplayResult replayRecording(const std::filesystem::path &path, BaseTracker &tracker, const ReplayOptions &options = {});
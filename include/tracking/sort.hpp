@@ -17,20 +17,49 @@ struct SortConfig
 
     size_t max_time_lost = 15;
     float match_thresh = 0.3f;
+
+    bool class_aware = false;
+    size_t num_threads = 1;
 };
 
 class Sort : public BaseTracker
 {
 public:
-    Sort(const SortConfig &t_config) : config(t_config) {}
+    Sort(const SortConfig &t_config) : config(t_config)
+    {
+        if (config.num_threads > 1)
+            setThreadPool(std::make_shared<ThreadPool>(config.num_threads));
+    }
     const SortConfig &getConfig() const { return config; };
     void update(std::vector<Detection> &detections) override;
 
 private:
+    friend class SortBatch;
+
     const SortConfig config;
+    void predict();
     void assign(std::vector<Detection> &detections,
                 float match_thresh,
                 std::set<std::pair<size_t, size_t>> &matches,
                 std::set<size_t> &unmatched_detections,
                 std::set<size_t> &unmatched_tracks);
+    void associate(std::vector<Detection *> &dets,
+                   std::vector<BaseTrack *> &trks,
+                   float match_thresh,
+                   std::set<std::pair<size_t, size_t>> &matches,
+                   std::set<size_t> &unmatched_detections,
+                   std::set<size_t> &unmatched_tracks);
+    void assign(const float *cost,
+                size_t stride,
+                const long *assignment,
+                size_t num_detections,
+                size_t num_tracks,
+                float match_thresh,
+                std::set<std::pair<size_t, size_t>> &matches,
+                std::set<size_t> &unmatched_detections,
+                std::set<size_t> &unmatched_tracks);
+    void commit(std::vector<Detection> &detections,
+                const std::set<std::pair<size_t, size_t>> &matches,
+                const std::set<size_t> &unmatched_detections,
+                const std::set<size_t> &unmatched_tracks);
 };
\ No newline at end of file
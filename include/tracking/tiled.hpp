@@ -0,0 +1,54 @@
+#pragma once
+
+#include <functional>
+#include <unordered_map>
+
+#include "tracker.hpp"
+
+struct TilingConfig
+{
+    float tile_width = 0.f; // 0 disables tiling
+    float tile_height = 0.f;
+    float overlap = 64.f;   // margin around each tile that it also tracks, in pixels
+    size_t num_threads = 0; // 0 uses all cores
+};
+
+// Splits the canvas into a grid of tiles, each tracked independently by its own
+// tracker. A tile sees the detections whose center falls inside the tile grown by
+// `overlap`, so an object crossing a border is tracked by both tiles for a while.
+// Ids of those shared detections are reconciled, which hands the global id over
+// to the next tile. Global ids are ids of the local tracks, unique process-wide, and
+// unique within a frame: a detection claiming an id already emitted gets a fresh one.
+// New local tracks are numbered in tile order, whatever the thread timing.
+//
+// Tiles are created lazily where detections appear and dropped once they hold no
+// tracks, so the per-frame cost follows the occupied area and tile density.
+// The tracks themselves live in the tile trackers: getTracks() stays empty.
+class TiledTracker : public BaseTracker
+{
+public:
+    using TrackerBuilder = std::function<std::unique_ptr<BaseTracker>()>;
+
+    TiledTracker(const TilingConfig &t_config, TrackerBuilder t_builder);
+    const TilingConfig &getConfig() const { return config; }
+    size_t getTileCount() const { return tiles.size(); }
+    void update(std::vector<Detection> &detections) override;
+
+    // Sum of the tile trackers, tiles and their routing buffers count as scratch
+    MemoryReport getMemoryReport() const override;
+
+private:
+    struct Tile
+    {
+        std::unique_ptr<BaseTracker> tracker = nullptr;
+        std::vector<Detection> detections{};
+        std::unordered_map<int, int> global_ids{}; // local track id -> global id
+    };
+
+    const TilingConfig config;
+    TrackerBuilder builder;
+    std::map<std::pair<int, int>, std::unique_ptr<Tile>> tiles{};
+
+    Tile &getTile(int col, int row);
+    void renumberNewTracks(const std::vector<Tile *> &active, int64_t first_new);
+};
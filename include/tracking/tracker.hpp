@@ -1,15 +1,48 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <stdexcept>
 #include <array>
+#include <map>
+#include <set>
 
 #include <types/detection.hpp>
 #include <kalman/kalman.hpp>
+#include <parallel/thread_pool.hpp>
+#include <tracking/profiler.hpp>
 
 constexpr float PRECISION = 1E6f;
 constexpr size_t MAX_HISTORY = 50;
+constexpr size_t PARALLEL_MIN_COST = 4096; // cost matrix cells below which a partition is not worth a pool task
+constexpr size_t PARALLEL_GRAIN = 32;      // minimum number of tracks / rows per pool task
+constexpr size_t SHARED_CONTROL_BLOCK = sizeof(void *) + 2 * sizeof(int); // vptr and counts of a make_shared block
+
+// Bytes held by a tracker's state, allocator overhead not included
+struct MemoryReport
+{
+    size_t tracks = 0;   // track objects and the track list
+    size_t filters = 0;  // Kalman filters, their matrices and shared_ptr control blocks
+    size_t history = 0;  // reserved box history
+    size_t features = 0; // appearance embeddings
+    size_t scratch = 0;  // buffers kept across frames
+    size_t num_tracks = 0;
+
+    size_t total() const { return tracks + filters + history + features + scratch; }
+
+    MemoryReport &operator+=(const MemoryReport &other)
+    {
+        tracks += other.tracks;
+        filters += other.filters;
+        history += other.history;
+        features += other.features;
+        scratch += other.scratch;
+        num_tracks += other.num_tracks;
+        return *this;
+    }
+};
 
 enum class TrackState : int
 {
@@ -21,8 +54,9 @@ enum class TrackState : int
 
 struct BaseTrack
 {
-    static int64_t count;
+    static std::atomic<int64_t> count; // shared by all trackers, ids are unique process-wide
     int id = 0;
+    int class_id = -1;
     size_t age = 0;
     size_t time_since_update = 0;
     TrackState state = TrackState::New;
@@ -37,6 +71,9 @@ struct BaseTrack
     virtual cv::Rect2f getBox() const;
     virtual cv::Point2f getVelocity() const;
 
+    // Adds what this track holds, by capacity rather than size
+    virtual void addMemory(MemoryReport &report) const;
+
     static int getNextId() { return ++count; }
     void clearCount() { count = 0; }
 
@@ -55,8 +92,140 @@ public:
     BaseTracker() = default;
     virtual ~BaseTracker() = default;
     virtual void update(std::vector<Detection> &detections) = 0;
-    const std::vector<std::unique_ptr<BaseTrack>> &getTracks() const { return tracks; }
+    virtual const std::vector<std::unique_ptr<BaseTrack>> &getTracks() const { return tracks; }
+
+    // Pool used for the parallel parts of update(), none means single-threaded
+    void setThreadPool(std::shared_ptr<ThreadPool> t_pool) { pool = std::move(t_pool); }
+
+    // Stage timings, matrix sizes and track counts of every update(), none disables them
+    void setProfiler(std::shared_ptr<TrackerProfiler> t_profiler) { profiler = std::move(t_profiler); }
+    const std::shared_ptr<TrackerProfiler> &getProfiler() const { return profiler; }
+
+    // Bytes currently held by tracks, features, history and scratch buffers
+    virtual MemoryReport getMemoryReport() const;
 
 protected:
     std::vector<std::unique_ptr<BaseTrack>> tracks{};
-};
\ No newline at end of file
+    std::shared_ptr<ThreadPool> pool = nullptr;
+    std::shared_ptr<TrackerProfiler> profiler = nullptr;
+
+    StageTimer profileStage(TrackerStage stage) const { return StageTimer(profiler.get(), stage); }
+
+    void profileMatrix([[maybe_unused]] size_t rows, [[maybe_unused]] size_t cols) const
+    {
+#ifndef MOT_NO_PROFILING
+        if (profiler) [[unlikely]]
+        {
+            profiler->recordMatrix(TrackerStage::Cost, rows, cols);
+            profiler->recordMatrix(TrackerStage::Solve, std::max(rows, cols), std::max(rows, cols));
+        }
+#endif
+    }
+
+    void profileTracks() const
+    {
+#ifndef MOT_NO_PROFILING
+        if (profiler) [[unlikely]]
+            countTracks();
+#endif
+    }
+
+    // Runs fn(i) for every i in [0, n), on the pool when there is one and enough work
+    template <typename F>
+    void parallelFor(size_t n, F &&fn) const
+    {
+        if (pool && n > PARALLEL_GRAIN)
+        {
+            pool->parallelFor(0, n, fn, PARALLEL_GRAIN);
+            return;
+        }
+        for (size_t i = 0; i < n; ++i)
+            fn(i);
+    }
+
+    void appendTracks(std::vector<std::unique_ptr<BaseTrack>> &new_tracks);
+    void countTracks() const;
+
+    template <typename Track, typename Associate>
+    void assignByClass(std::vector<Detection *> &dets,
+                       std::vector<Track *> &trks,
+                       Associate &&associate,
+                       std::set<std::pair<size_t, size_t>> &matches,
+                       std::set<size_t> &unmatched_detections,
+                       std::set<size_t> &unmatched_tracks);
+};
+
+// Partitions detections and tracks by class id and runs `associate` on every partition
+// independently, so tracks only ever match detections of their own class. Results are
+// mapped back to indices of `dets` / `trks` and merged into ordered sets, which keeps
+// the outcome independent of the order partitions complete in.
+template <typename Track, typename Associate>
+void BaseTracker::assignByClass(std::vector<Detection *> &dets,
+                                std::vector<Track *> &trks,
+                                Associate &&associate,
+                                std::set<std::pair<size_t, size_t>> &matches,
+                                std::set<size_t> &unmatched_detections,
+                                std::set<size_t> &unmatched_tracks)
+{
+    struct Partition
+    {
+        std::vector<size_t> det_indices{};
+        std::vector<size_t> track_indices{};
+        std::vector<Detection *> dets{};
+        std::vector<Track *> trks{};
+        std::set<std::pair<size_t, size_t>> matches{};
+        std::set<size_t> unmatched_detections{};
+        std::set<size_t> unmatched_tracks{};
+    };
+
+    // Group by class id
+    std::map<int, Partition> groups;
+    for (size_t i = 0; i < dets.size(); ++i)
+    {
+        auto &group = groups[dets[i]->class_id];
+        group.det_indices.push_back(i);
+        group.dets.push_back(dets[i]);
+    }
+    for (size_t j = 0; j < trks.size(); ++j)
+    {
+        auto &group = groups[trks[j]->class_id];
+        group.track_indices.push_back(j);
+        group.trks.push_back(trks[j]);
+    }
+
+    std::vector<Partition *> partitions;
+    bool large = false;
+    for (auto &[class_id, group] : groups)
+    {
+        partitions.push_back(&group);
+        large |= group.dets.size() * group.trks.size() >= PARALLEL_MIN_COST;
+    }
+
+    // Solve partitions, on the pool when at least one of them is worth it
+    auto solve = [&](size_t p)
+    {
+        auto &part = *partitions[p];
+        associate(part.dets, part.trks, part.matches, part.unmatched_detections, part.unmatched_tracks);
+    };
+
+    if (pool && large && partitions.size() > 1)
+    {
+        pool->parallelFor(0, partitions.size(), solve);
+    }
+    else
+    {
+        for (size_t p = 0; p < partitions.size(); ++p)
+            solve(p);
+    }
+
+    // Map back to the original indices
+    for (const auto *part : partitions)
+    {
+        for (const auto &[det_idx, track_idx] : part->matches)
+            matches.emplace(part->det_indices[det_idx], part->track_indices[track_idx]);
+        for (const auto &det_idx : part->unmatched_detections)
+            unmatched_detections.insert(part->det_indices[det_idx]);
+        for (const auto &track_idx : part->unmatched_tracks)
+            unmatched_tracks.insert(part->track_indices[track_idx]);
+    }
+}
\ No newline at end of file
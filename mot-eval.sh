@@ -56,25 +56,21 @@ if [ "$gt" = true ] && [ "$split" != "train" ]; then
     exit 1
 fi
 
-# Locate mot binary
+# Locate mot binaries
 if command -v mot &> /dev/null; then
     MOT_BIN="mot"
+    BENCH_BIN="mot-bench"
+    METRICS_BIN="mot-metrics"
 elif [ -f "./build/app/mot" ]; then
     MOT_BIN="./build/app/mot"
+    BENCH_BIN="./build/app/mot-bench"
+    METRICS_BIN="./build/app/mot-metrics"
 else
     echo "Error: mot binary not found. Compile the project first:"
     echo "meson compile -C build"
     exit 1
 fi
 
-if [ -f "venv/bin/python3" ]; then
-    PYTHON_BIN="venv/bin/python3"
-else
-    echo "Error: python venv binary not found. Create the venv first:"
-    echo "python3 -m venv venv && ./venv/bin/pip install -r requirements.txt"
-    exit 1
-fi
-
 # Get all sequence directories
 seq_dir="$dataset/$split"
 if [ ! -d "$seq_dir" ]; then
@@ -101,21 +97,28 @@ cp "$config" "$exp_dir/"
 } > "$exp_dir/cli.txt"
 
 # Run tracker on each sequence
-for seq in $seq_dir/*; do
-    if [ -d "$seq" ]; then
-        seq=${seq%/}
-        echo "Processing sequence: $seq"
-        cmd="$MOT_BIN --input $seq --config $config --output $output_dir"
-        [ "$save" = true ] && cmd="$cmd --save"
-        [ "$gt" = true ] && cmd="$cmd --gt"
-        $cmd
-    fi
-done
+if [ "$save" = true ]; then
+    for seq in $seq_dir/*; do
+        if [ -d "$seq" ]; then
+            seq=${seq%/}
+            echo "Processing sequence: $seq"
+            cmd="$MOT_BIN --input $seq --config $config --output $output_dir --save"
+            [ "$gt" = true ] && cmd="$cmd --gt"
+            $cmd
+        fi
+    done
+else
+    # All sequences in one process, in parallel
+    cmd="$BENCH_BIN --dataset $dataset --split $split --config $config --output $output_dir"
+    [ "$gt" = true ] && cmd="$cmd --gt"
+    $cmd | tee "$exp_dir/timing.txt"
+    mv "$output_dir/summary.csv" "$exp_dir/"
+fi
 
 # Run evaluation only for train split
 if [ "$split" = "train" ]; then
     echo "Running evaluation..."
-    $PYTHON_BIN -m motmetrics.apps.eval_motchallenge "$dataset/$split" "$output_dir" 2>&1 | tee "$exp_dir/metrics.txt"
+    $METRICS_BIN --dataset "$dataset" --split "$split" --results "$output_dir" --output "$exp_dir/metrics.csv" 2>&1 | tee "$exp_dir/metrics.txt"
 else
     echo "Skipping evaluation for test split (no ground truth available)"
 fi
\ No newline at end of file
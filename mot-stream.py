@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""Replays a MOT det.txt as a live detector would, for `mot --stream`.
+
+Frames are sent as MOT lines followed by an empty line, paced at --fps.
+
+    # stdin: results are printed by mot
+    ./mot-stream.py --input data/MOT20/train/MOT20-01 | ./build/app/mot --stream stdin -c app/config/sort.toml
+
+    # Unix socket: start `mot --stream unix:/tmp/mot.sock -c ...` first, results and
+    # round-trip latency are reported here
+    ./mot-stream.py --input data/MOT20/train/MOT20-01 --socket /tmp/mot.sock
+"""
+
+import argparse
+import os
+import socket
+import sys
+import threading
+import time
+from collections import defaultdict
+
+
+def load_frames(det_path):
+    frames = defaultdict(list)
+    with open(det_path) as f:
+        for line in f:
+            line = line.strip()
+            if line:
+                frames[int(line.split(",")[0])].append(line)
+    last = max(frames) if frames else 0
+    return [frames.get(frame_id, []) for frame_id in range(1, last + 1)]
+
+
+def encode(lines):
+    return ("\n".join(lines) + "\n\n" if lines else "\n").encode()
+
+
+def receive(sock, sent_at, latencies, output):
+    buffer = b""
+    frame = 0
+    while True:
+        data = sock.recv(65536)
+        if not data:
+            break
+        buffer += data
+        # Every response frame ends with an empty line
+        while b"\n\n" in buffer or buffer.startswith(b"\n"):
+            if buffer.startswith(b"\n"):
+                block, buffer = b"", buffer[1:]
+            else:
+                block, buffer = buffer.split(b"\n\n", 1)
+            latencies.append((time.perf_counter() - sent_at[frame]) * 1000.0)
+            frame += 1
+            if output and block:
+                output.write(block.decode() + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Stream MOT detections to `mot --stream`")
+    parser.add_argument("--input", "-i", required=True, help="MOT sequence folder")
+    parser.add_argument("--gt", action="store_true", help="Use ground-truth detections")
+    parser.add_argument("--socket", "-s", help="Unix socket of `mot --stream unix:<path>`, stdout otherwise")
+    parser.add_argument("--fps", type=float, default=30.0, help="Frames per second, 0 for as fast as possible")
+    parser.add_argument("--output", "-o", help="Write the received tracks to this file (socket mode)")
+    args = parser.parse_args()
+
+    det_path = os.path.join(args.input, "gt/gt.txt" if args.gt else "det/det.txt")
+    frames = load_frames(det_path)
+    period = 1.0 / args.fps if args.fps > 0 else 0.0
+
+    if not args.socket:
+        out = sys.stdout.buffer
+        start = time.perf_counter()
+        for k, lines in enumerate(frames):
+            if period:
+                time.sleep(max(0.0, start + k * period - time.perf_counter()))
+            out.write(encode(lines))
+            out.flush()
+        return
+
+    sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    sock.connect(args.socket)
+
+    sent_at = [0.0] * len(frames)
+    latencies = []
+    output = open(args.output, "w") if args.output else None
+    receiver = threading.Thread(target=receive, args=(sock, sent_at, latencies, output))
+    receiver.start()
+
+    start = time.perf_counter()
+    for k, lines in enumerate(frames):
+        if period:
+            time.sleep(max(0.0, start + k * period - time.perf_counter()))
+        sent_at[k] = time.perf_counter()
+        sock.sendall(encode(lines))
+    sock.shutdown(socket.SHUT_WR)
+    receiver.join()
+    sock.close()
+    if output:
+        output.close()
+
+    if latencies:
+        latencies.sort()
+        p = lambda q: latencies[min(len(latencies) - 1, int(q * (len(latencies) - 1) + 0.5))]
+        print(f"{len(latencies)} frames, round-trip p50 {p(0.5):.3f} ms, p99 {p(0.99):.3f} ms, max {latencies[-1]:.3f} ms",
+              file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
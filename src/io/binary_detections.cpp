@@ -0,0 +1,201 @@
+#include <io/binary_detections.hpp>
+#include <trace/trace.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+static_assert(std::endian::native == std::endian::little, "Binary detection files are little-endian");
+static_assert(sizeof(BinaryHeader) == 32);
+
+namespace
+{
+    size_t alignUp(size_t offset)
+    {
+        return (offset + BINARY_ALIGNMENT - 1) / BINARY_ALIGNMENT * BINARY_ALIGNMENT;
+    }
+
+    // Byte offsets of every section, shared by the reader and the writer
+    struct Layout
+    {
+        size_t index, x, y, w, h, confidence, class_id, track_id, features, end;
+
+        Layout(size_t num_frames, size_t num_rows, size_t feature_dim)
+        {
+            index = alignUp(sizeof(BinaryHeader));
+            x = alignUp(index + (num_frames + 1) * sizeof(uint64_t));
+            y = alignUp(x + num_rows * sizeof(float));
+            w = alignUp(y + num_rows * sizeof(float));
+            h = alignUp(w + num_rows * sizeof(float));
+            confidence = alignUp(h + num_rows * sizeof(float));
+            class_id = alignUp(confidence + num_rows * sizeof(float));
+            track_id = alignUp(class_id + num_rows * sizeof(int32_t));
+            features = alignUp(track_id + num_rows * sizeof(int32_t));
+            end = features + num_rows * feature_dim * sizeof(float);
+        }
+    };
+
+    size_t frameCount(const BinaryHeader &header)
+    {
+        return header.num_rows == 0 ? 0 : static_cast<size_t>(static_cast<int64_t>(header.last_frame) - header.first_frame) + 1;
+    }
+}
+
+BinaryDetectionFile::BinaryDetectionFile(const std::filesystem::path &path) : file(path)
+{
+    if (file.size() < sizeof(BinaryHeader))
+        throw std::runtime_error("Truncated binary detection file: " + path.string());
+
+    std::memcpy(&header, file.data(), sizeof(BinaryHeader));
+    if (std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0)
+        throw std::runtime_error("Not a binary detection file: " + path.string());
+    if (header.version != BINARY_VERSION)
+        throw std::runtime_error("Unsupported binary detection version " + std::to_string(header.version) + ": " + path.string());
+    if (header.num_rows > 0 && header.last_frame < header.first_frame)
+        throw std::runtime_error("Invalid frame range in binary detection file: " + path.string());
+
+    // Every section must fit in the file on its own, which also keeps the layout
+    // arithmetic below from overflowing
+    size_t num_frames = frameCount(header);
+    size_t max_values = file.size() / sizeof(float);
+    if (num_frames >= file.size() / sizeof(uint64_t) || header.num_rows > max_values ||
+        (header.feature_dim > 0 && header.num_rows > max_values / header.feature_dim))
+        throw std::runtime_error("Truncated binary detection file: " + path.string());
+
+    Layout layout(num_frames, header.num_rows, header.feature_dim);
+    if (file.size() < layout.end)
+        throw std::runtime_error("Truncated binary detection file: " + path.string());
+
+    const char *base = file.data();
+    index = reinterpret_cast<const uint64_t *>(base + layout.index);
+    x = reinterpret_cast<const float *>(base + layout.x);
+    y = reinterpret_cast<const float *>(base + layout.y);
+    w = reinterpret_cast<const float *>(base + layout.w);
+    h = reinterpret_cast<const float *>(base + layout.h);
+    confidence = reinterpret_cast<const float *>(base + layout.confidence);
+    class_id = reinterpret_cast<const int32_t *>(base + layout.class_id);
+    track_id = reinterpret_cast<const int32_t *>(base + layout.track_id);
+    features = reinterpret_cast<const float *>(base + layout.features);
+
+    // Frame spans must stay inside the columns
+    if (index[0] != 0 || index[num_frames] != header.num_rows)
+        throw std::runtime_error("Invalid frame index in binary detection file: " + path.string());
+    for (size_t f = 0; f < num_frames; ++f)
+    {
+        if (index[f + 1] < index[f])
+            throw std::runtime_error("Invalid frame index in binary detection file: " + path.string());
+    }
+}
+
+BinaryFrame BinaryDetectionFile::getFrame(int frame_id) const
+{
+    if (empty() || frame_id < header.first_frame || frame_id > header.last_frame)
+        return {};
+
+    size_t f = static_cast<size_t>(frame_id - header.first_frame);
+    size_t begin = index[f];
+    size_t count = index[f + 1] - begin;
+
+    BinaryFrame frame;
+    frame.x = {x + begin, count};
+    frame.y = {y + begin, count};
+    frame.w = {w + begin, count};
+    frame.h = {h + begin, count};
+    frame.confidence = {confidence + begin, count};
+    frame.class_id = {class_id + begin, count};
+    frame.track_id = {track_id + begin, count};
+    frame.features = {features + begin * header.feature_dim, count * header.feature_dim};
+    frame.feature_dim = header.feature_dim;
+    return frame;
+}
+
+void BinaryDetectionFile::readFrame(int frame_id, std::vector<Detection> &detections) const
+{
+    trace::Scope scope("read frame", "io");
+    BinaryFrame frame = getFrame(frame_id);
+    detections.resize(frame.size());
+
+    for (size_t i = 0; i < frame.size(); ++i)
+    {
+        auto &det = detections[i];
+        det.frame_id = frame_id;
+        det.track_id = frame.track_id[i];
+        det.class_id = frame.class_id[i];
+        det.confidence = frame.confidence[i];
+        det.bbox = cv::Rect2f(frame.x[i], frame.y[i], frame.w[i], frame.h[i]);
+
+        auto feature = frame.features.subspan(i * frame.feature_dim, frame.feature_dim);
+        det.features.assign(feature.begin(), feature.end());
+    }
+}
+
+void writeBinaryDetections(const std::filesystem::path &path,
+                           std::span<const Detection> detections,
+                           std::span<const float> features,
+                           size_t feature_dim)
+{
+    bool external = !features.empty();
+    if (external && features.size() != detections.size() * feature_dim)
+        throw std::invalid_argument("Expected " + std::to_string(feature_dim) + " features per detection");
+
+    BinaryHeader header{};
+    std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.num_rows = detections.size();
+    header.first_frame = detections.empty() ? 0 : detections.front().frame_id;
+    header.last_frame = detections.empty() ? -1 : detections.back().frame_id;
+    header.feature_dim = external ? static_cast<uint32_t>(feature_dim)
+                                  : detections.empty() ? 0
+                                                       : static_cast<uint32_t>(detections.front().features.size());
+
+    for (size_t i = 0; i < detections.size(); ++i)
+    {
+        if (i > 0 && detections[i].frame_id < detections[i - 1].frame_id)
+            throw std::invalid_argument("Detections must be ordered by frame");
+        if (!external && detections[i].features.size() != header.feature_dim)
+            throw std::invalid_argument("Detections must all have " + std::to_string(header.feature_dim) + " features");
+    }
+
+    size_t num_frames = frameCount(header);
+    Layout layout(num_frames, header.num_rows, header.feature_dim);
+
+    // Frame index
+    std::vector<uint64_t> index(num_frames + 1, 0);
+    for (const auto &det : detections)
+        index[det.frame_id - header.first_frame + 1]++;
+    for (size_t f = 1; f < index.size(); ++f)
+        index[f] += index[f - 1];
+
+    // Assemble the whole file, sections are padded with zeros
+    std::vector<char> buffer(layout.end, 0);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + layout.index, index.data(), index.size() * sizeof(uint64_t));
+
+    auto column = [&](size_t offset)
+    { return reinterpret_cast<float *>(buffer.data() + offset); };
+    auto int_column = [&](size_t offset)
+    { return reinterpret_cast<int32_t *>(buffer.data() + offset); };
+
+    for (size_t i = 0; i < detections.size(); ++i)
+    {
+        const auto &det = detections[i];
+        column(layout.x)[i] = det.bbox.x;
+        column(layout.y)[i] = det.bbox.y;
+        column(layout.w)[i] = det.bbox.width;
+        column(layout.h)[i] = det.bbox.height;
+        column(layout.confidence)[i] = det.confidence;
+        int_column(layout.class_id)[i] = det.class_id;
+        int_column(layout.track_id)[i] = det.track_id;
+        auto feature = external ? features.subspan(i * feature_dim, feature_dim) : std::span<const float>(det.features);
+        std::copy(feature.begin(), feature.end(), column(layout.features) + i * header.feature_dim);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        throw std::runtime_error("Could not open " + path.string());
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!file)
+        throw std::runtime_error("Could not write " + path.string());
+}
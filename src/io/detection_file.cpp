@@ -0,0 +1,153 @@
+#include <io/detection_file.hpp>
+#include <io/mapped_file.hpp>
+#include <trace/trace.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // Cursor over one line of comma or whitespace separated values
+    struct LineParser
+    {
+        const char *pos;
+        const char *end;
+
+        void skipSeparators()
+        {
+            while (pos < end && (*pos == ',' || *pos == ' ' || *pos == '\t' || *pos == '\r'))
+                ++pos;
+        }
+
+        template <typename T>
+        bool next(T &value)
+        {
+            skipSeparators();
+            auto [ptr, ec] = std::from_chars(pos, end, value);
+            if (ec != std::errc())
+                return false;
+            pos = ptr;
+            return true;
+        }
+    };
+}
+
+bool isBlankLine(std::string_view line)
+{
+    LineParser parser{line.data(), line.data() + line.size()};
+    parser.skipSeparators();
+    return parser.pos == parser.end;
+}
+
+bool parseDetection(std::string_view line, Detection &det)
+{
+    LineParser parser{line.data(), line.data() + line.size()};
+    float x, y, w, h;
+    bool valid = parser.next(det.frame_id) && parser.next(det.track_id) &&
+                 parser.next(x) && parser.next(y) && parser.next(w) && parser.next(h) &&
+                 parser.next(det.confidence);
+    if (!valid)
+        return false;
+
+    // Ground-truth layout carries the class in the 8th column
+    int class_id;
+    if (parser.next(class_id))
+        det.class_id = class_id;
+
+    det.bbox = cv::Rect2f(x, y, w, h);
+    return true;
+}
+
+DetectionFile::DetectionFile(const std::filesystem::path &path)
+{
+    trace::Scope scope("parse detections", "io");
+    MappedFile file(path);
+    const char *data = file.data();
+    const char *end = data + file.size();
+
+    // Parse every row, at most one allocation per doubling of the buffer
+    std::vector<Detection> parsed;
+    parsed.reserve(file.size() / 48);
+
+    size_t line_number = 0;
+    for (const char *line = data; line < end;)
+    {
+        const char *eol = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        if (!eol)
+            eol = end;
+        ++line_number;
+
+        std::string_view text(line, static_cast<size_t>(eol - line));
+        if (!isBlankLine(text))
+        {
+            Detection det;
+            if (!parseDetection(text, det))
+                throw std::runtime_error("Malformed detection at " + path.string() + ":" + std::to_string(line_number));
+            if (det.frame_id < 1 || det.frame_id > MAX_FRAME_ID)
+                throw std::runtime_error("Frame id " + std::to_string(det.frame_id) + " out of range at " + path.string() + ":" + std::to_string(line_number));
+            parsed.push_back(std::move(det));
+        }
+
+        line = eol + 1;
+    }
+
+    if (parsed.empty())
+        return;
+
+    // Frame index, counting sort keeps the file order within a frame
+    first_frame = parsed.front().frame_id;
+    last_frame = parsed.front().frame_id;
+    for (const auto &det : parsed)
+    {
+        first_frame = std::min(first_frame, det.frame_id);
+        last_frame = std::max(last_frame, det.frame_id);
+    }
+
+    // Ids are within [1, MAX_FRAME_ID], the span neither overflows nor gets huge
+    offsets.assign(static_cast<size_t>(static_cast<int64_t>(last_frame) - first_frame) + 2, 0);
+    for (const auto &det : parsed)
+        offsets[det.frame_id - first_frame + 1]++;
+    for (size_t f = 1; f < offsets.size(); ++f)
+        offsets[f] += offsets[f - 1];
+
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    detections.resize(parsed.size());
+    rows.resize(parsed.size());
+    for (size_t row = 0; row < parsed.size(); ++row)
+    {
+        size_t slot = cursor[parsed[row].frame_id - first_frame]++;
+        detections[slot] = std::move(parsed[row]);
+        rows[slot] = row;
+    }
+}
+
+std::span<Detection> DetectionFile::getFrame(int frame_id)
+{
+    if (frame_id < first_frame || frame_id > last_frame)
+        return {};
+
+    size_t f = static_cast<size_t>(frame_id - first_frame);
+    return std::span<Detection>(detections).subspan(offsets[f], offsets[f + 1] - offsets[f]);
+}
+
+std::span<const Detection> DetectionFile::getFrame(int frame_id) const
+{
+    if (frame_id < first_frame || frame_id > last_frame)
+        return {};
+
+    size_t f = static_cast<size_t>(frame_id - first_frame);
+    return std::span<const Detection>(detections).subspan(offsets[f], offsets[f + 1] - offsets[f]);
+}
+
+std::span<const size_t> DetectionFile::getFrameRows(int frame_id) const
+{
+    if (frame_id < first_frame || frame_id > last_frame)
+        return {};
+
+    size_t f = static_cast<size_t>(frame_id - first_frame);
+    return std::span<const size_t>(rows).subspan(offsets[f], offsets[f + 1] - offsets[f]);
+}
@@ -0,0 +1,150 @@
+#include <io/frame_source.hpp>
+#include <trace/trace.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+ImageFolderSource::ImageFolderSource(const std::filesystem::path &directory, double t_frame_rate) : frame_rate(t_frame_rate)
+{
+    if (!std::filesystem::is_directory(directory))
+        throw std::runtime_error("Image directory does not exist: " + directory.string());
+
+    for (const auto &entry : std::filesystem::directory_iterator(directory))
+    {
+        if (entry.is_regular_file())
+            files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    // Size of the sequence from its first image
+    if (!files.empty())
+    {
+        cv::Mat first = cv::imread(files.front().string(), cv::IMREAD_COLOR);
+        frame_size = first.size();
+    }
+}
+
+bool ImageFolderSource::readAt(size_t index, cv::Mat &image) const
+{
+    if (index >= files.size())
+        return false;
+
+    image = cv::imread(files[index].string(), cv::IMREAD_COLOR);
+    return !image.empty();
+}
+
+VideoSource::VideoSource(const std::string &path) : capture(path)
+{
+    if (!capture.isOpened())
+        throw std::runtime_error("Could not open video: " + path);
+}
+
+VideoSource::VideoSource(int device) : capture(device)
+{
+    if (!capture.isOpened())
+        throw std::runtime_error("Could not open camera " + std::to_string(device));
+}
+
+int VideoSource::getFrameCount() const
+{
+    return std::max(0, static_cast<int>(capture.get(cv::CAP_PROP_FRAME_COUNT)));
+}
+
+double VideoSource::getFrameRate() const
+{
+    return std::max(0., capture.get(cv::CAP_PROP_FPS));
+}
+
+cv::Size VideoSource::getFrameSize() const
+{
+    return {static_cast<int>(capture.get(cv::CAP_PROP_FRAME_WIDTH)), static_cast<int>(capture.get(cv::CAP_PROP_FRAME_HEIGHT))};
+}
+
+ThreadedFrameSource::ThreadedFrameSource(std::unique_ptr<FrameSource> t_source, size_t prefetch, size_t num_threads)
+    : source(std::move(t_source)), slots(std::max<size_t>(prefetch, 1))
+{
+    if (!source->isRandomAccess())
+        num_threads = 1;
+
+    num_threads = std::clamp<size_t>(num_threads, 1, slots.size());
+    for (size_t i = 0; i < num_threads; ++i)
+        workers.emplace_back(&ThreadedFrameSource::run, this);
+}
+
+ThreadedFrameSource::~ThreadedFrameSource()
+{
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void ThreadedFrameSource::run()
+{
+    trace::setThreadName("decoder");
+    std::unique_lock lock(mutex);
+    while (true)
+    {
+        // Wait for a free slot, at most slots.size() frames ahead of the caller
+        cv.wait(lock, [this]
+                { return stopping || exhausted || next_claim < next_read + slots.size(); });
+        if (stopping || exhausted)
+            return;
+
+        size_t index = next_claim++;
+        Slot &slot = slots[index % slots.size()];
+
+        // Decode into the pooled buffer outside the lock
+        cv::Mat buffer;
+        std::swap(buffer, slot.image);
+        lock.unlock();
+
+        bool valid;
+        {
+            trace::Scope scope("decode", "io");
+            valid = source->isRandomAccess() ? source->readAt(index, buffer) : source->read(buffer);
+        }
+
+        lock.lock();
+        std::swap(buffer, slot.image);
+        slot.index = index;
+        slot.valid = valid;
+        slot.ready = true;
+        if (!valid)
+            exhausted = true;
+        cv.notify_all();
+    }
+}
+
+bool ThreadedFrameSource::read(cv::Mat &image)
+{
+    std::unique_lock lock(mutex);
+    Slot &slot = slots[next_read % slots.size()];
+    cv.wait(lock, [&]
+            { return slot.ready && slot.index == next_read; });
+
+    // The end stays readable, every later call returns false as well
+    if (!slot.valid)
+        return false;
+
+    std::swap(image, slot.image);
+    slot.ready = false;
+    next_read++;
+    cv.notify_all();
+    return true;
+}
+
+std::unique_ptr<FrameSource> openFrameSource(const std::string &path, double frame_rate)
+{
+    if (!path.empty() && std::all_of(path.begin(), path.end(), [](char c)
+                                     { return c >= '0' && c <= '9'; }))
+        return std::make_unique<VideoSource>(std::stoi(path));
+
+    if (std::filesystem::is_directory(path))
+        return std::make_unique<ImageFolderSource>(path, frame_rate);
+
+    return std::make_unique<VideoSource>(path);
+}
@@ -0,0 +1,65 @@
+#include <io/mapped_file.hpp>
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::filesystem::path &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), "Could not open " + path.string());
+
+    struct stat info{};
+    if (::fstat(fd, &info) < 0)
+    {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "Could not stat " + path.string());
+    }
+
+    length = static_cast<size_t>(info.st_size);
+    if (length > 0)
+    {
+        address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            int error = errno;
+            ::close(fd);
+            address = nullptr;
+            throw std::system_error(error, std::generic_category(), "Could not map " + path.string());
+        }
+        ::madvise(address, length, MADV_SEQUENTIAL);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (address)
+        ::munmap(address, length);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : address(std::exchange(other.address, nullptr)), length(std::exchange(other.length, 0))
+{
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (address)
+            ::munmap(address, length);
+        address = std::exchange(other.address, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
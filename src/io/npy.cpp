@@ -0,0 +1,144 @@
+#include <io/npy.hpp>
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // Value of `key` in the header dict, up to the next top-level comma or the closing brace
+    std::string_view dictValue(std::string_view header, std::string_view key)
+    {
+        size_t pos = header.find("'" + std::string(key) + "'");
+        if (pos == std::string_view::npos)
+            return {};
+
+        pos = header.find(':', pos);
+        if (pos == std::string_view::npos)
+            return {};
+
+        size_t end = pos + 1;
+        int depth = 0;
+        for (; end < header.size(); ++end)
+        {
+            char c = header[end];
+            if (c == '(')
+                depth++;
+            else if (c == ')')
+                depth--;
+            else if ((c == ',' || c == '}') && depth == 0)
+                break;
+        }
+
+        std::string_view value = header.substr(pos + 1, end - pos - 1);
+        while (!value.empty() && value.front() == ' ')
+            value.remove_prefix(1);
+        while (!value.empty() && value.back() == ' ')
+            value.remove_suffix(1);
+        return value;
+    }
+
+    std::vector<size_t> parseShape(std::string_view value)
+    {
+        std::vector<size_t> shape;
+        const char *p = value.data();
+        const char *end = value.data() + value.size();
+        while (p < end)
+        {
+            if (*p < '0' || *p > '9')
+            {
+                ++p;
+                continue;
+            }
+            size_t dim = 0;
+            p = std::from_chars(p, end, dim).ptr;
+            shape.push_back(dim);
+        }
+        return shape;
+    }
+}
+
+NpyArray::NpyArray(const std::filesystem::path &path) : file(path)
+{
+    constexpr std::string_view magic = "\x93NUMPY";
+    std::string_view data = file.view();
+    if (data.size() < 10 || data.substr(0, magic.size()) != magic)
+        throw std::runtime_error("Not a .npy file: " + path.string());
+
+    // Version 1 has a 2-byte header length, versions 2 and 3 a 4-byte one
+    uint8_t major = static_cast<uint8_t>(data[6]);
+    size_t header_start, header_size;
+    if (major == 1)
+    {
+        header_start = 10;
+        header_size = static_cast<uint8_t>(data[8]) | static_cast<size_t>(static_cast<uint8_t>(data[9])) << 8;
+    }
+    else if (major == 2 || major == 3)
+    {
+        if (data.size() < 12)
+            throw std::runtime_error("Truncated .npy file: " + path.string());
+        uint32_t size;
+        std::memcpy(&size, data.data() + 8, sizeof(size));
+        header_start = 12;
+        header_size = size;
+    }
+    else
+    {
+        throw std::runtime_error("Unsupported .npy version " + std::to_string(major) + ": " + path.string());
+    }
+
+    if (data.size() < header_start + header_size)
+        throw std::runtime_error("Truncated .npy file: " + path.string());
+    std::string_view header = data.substr(header_start, header_size);
+
+    std::string_view descr = dictValue(header, "descr");
+    if (descr != "'<f4'" && descr != "'=f4'")
+        throw std::runtime_error("Expected a float32 .npy array, got " + std::string(descr) + ": " + path.string());
+    if (dictValue(header, "fortran_order") != "False")
+        throw std::runtime_error("Expected a C-ordered .npy array: " + path.string());
+
+    auto shape = parseShape(dictValue(header, "shape"));
+    if (shape.size() != 2)
+        throw std::runtime_error("Expected a 2-D .npy array: " + path.string());
+    num_rows = shape[0];
+    num_cols = shape[1];
+
+    // The header fits in the file, so only the shape product can overflow
+    size_t data_offset = header_start + header_size;
+    if (num_cols != 0 && num_rows > (data.size() - data_offset) / sizeof(float) / num_cols)
+        throw std::runtime_error("Truncated .npy file: " + path.string());
+    if (data_offset % alignof(float) != 0)
+        throw std::runtime_error("Misaligned .npy data: " + path.string());
+
+    values = reinterpret_cast<const float *>(data.data() + data_offset);
+}
+
+void writeNpy(const std::filesystem::path &path, std::span<const float> values, size_t cols)
+{
+    if (cols == 0 || values.size() % cols != 0)
+        throw std::invalid_argument("writeNpy: " + std::to_string(values.size()) + " values do not fill rows of " + std::to_string(cols));
+
+    // Version 1 header, padded so the data starts on a 64-byte boundary like numpy.save
+    std::string header = "{'descr': '<f4', 'fortran_order': False, 'shape': (" +
+                         std::to_string(values.size() / cols) + ", " + std::to_string(cols) + "), }";
+    while ((10 + header.size() + 1) % 64 != 0)
+        header += ' ';
+    header += '\n';
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+        throw std::runtime_error("Could not open " + path.string());
+
+    file.write("\x93NUMPY\x01\x00", 8);
+    char size[2] = {static_cast<char>(header.size() & 0xff), static_cast<char>(header.size() >> 8)};
+    file.write(size, 2);
+    file << header;
+    file.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+    if (!file)
+        throw std::runtime_error("Could not write " + path.string());
+}
@@ -0,0 +1,269 @@
+#include <io/result_writer.hpp>
+#include <io/trajectory_file.hpp>
+#include <trace/trace.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace
+{
+    // Longest text line: 2 ints, 5 floats in %g form and the constant tail
+    constexpr size_t MAX_LINE_SIZE = 2 * 12 + 5 * 16 + 16;
+
+    char *writeInt(char *p, char *end, int value)
+    {
+        return std::to_chars(p, end, value).ptr;
+    }
+
+    // Same digits as the default std::ostream formatting of a float
+    char *writeFloat(char *p, char *end, float value)
+    {
+        return std::to_chars(p, end, value, std::chars_format::general, 6).ptr;
+    }
+}
+
+ResultWriter::ResultWriter(const std::filesystem::path &path, ResultFormat t_format, bool background, size_t buffer_size)
+    : format(t_format), capacity(std::max(buffer_size, MAX_LINE_SIZE))
+{
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), "Could not open " + path.string());
+    owns_fd = true;
+    start(background);
+}
+
+ResultWriter::ResultWriter(int t_fd, ResultFormat t_format, bool background, size_t buffer_size)
+    : fd(t_fd), format(t_format), capacity(std::max(buffer_size, MAX_LINE_SIZE))
+{
+    start(background);
+}
+
+ResultWriter::~ResultWriter()
+{
+    try
+    {
+        flush();
+    }
+    catch (...)
+    {
+        // Destructors must not throw, call flush() to observe write errors
+    }
+
+    if (worker.joinable())
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+
+    if (owns_fd)
+        ::close(fd);
+}
+
+void ResultWriter::start(bool background)
+{
+    buffer.resize(capacity);
+    writeHeader();
+
+    if (background)
+        worker = std::thread(&ResultWriter::run, this);
+}
+
+void ResultWriter::writeHeader()
+{
+    if (format != ResultFormat::Binary)
+        return;
+
+    TrajectoryHeader header{};
+    std::memcpy(header.magic, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC));
+    header.version = TRAJECTORY_VERSION;
+    header.row_size = sizeof(TrajectoryRow);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    used = sizeof(header);
+}
+
+void ResultWriter::write(std::span<const Detection> detections)
+{
+    rethrow();
+
+    for (const auto &det : detections)
+    {
+        if (capacity - used < MAX_LINE_SIZE)
+            submit();
+
+        char *p = buffer.data() + used;
+        if (format == ResultFormat::Binary)
+        {
+            TrajectoryRow row{det.frame_id, det.track_id, det.class_id,
+                              det.bbox.x, det.bbox.y, det.bbox.width, det.bbox.height,
+                              det.confidence};
+            std::memcpy(p, &row, sizeof(row));
+            used += sizeof(row);
+            continue;
+        }
+
+        char *end = buffer.data() + capacity;
+        p = writeInt(p, end, det.frame_id);
+        *p++ = ',';
+        p = writeInt(p, end, det.track_id);
+        *p++ = ',';
+        p = writeFloat(p, end, det.bbox.x);
+        *p++ = ',';
+        p = writeFloat(p, end, det.bbox.y);
+        *p++ = ',';
+        p = writeFloat(p, end, det.bbox.width);
+        *p++ = ',';
+        p = writeFloat(p, end, det.bbox.height);
+        *p++ = ',';
+        p = writeFloat(p, end, det.confidence);
+        constexpr std::string_view tail = ",-1,-1,-1\n";
+        p = std::copy(tail.begin(), tail.end(), p);
+        used = static_cast<size_t>(p - buffer.data());
+    }
+}
+
+void ResultWriter::endFrame()
+{
+    if (format != ResultFormat::Text)
+        return;
+
+    if (used == capacity)
+        submit();
+    buffer[used++] = '\n';
+}
+
+void ResultWriter::flush()
+{
+    submit();
+
+    if (worker.joinable())
+    {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [this]
+                { return (pending.empty() && !writing) || error; });
+    }
+    rethrow();
+}
+
+// Hands the current buffer over, inline or to the background thread
+void ResultWriter::submit()
+{
+    if (used == 0)
+        return;
+
+    if (!worker.joinable())
+    {
+        writeAll(buffer.data(), used);
+        used = 0;
+        return;
+    }
+
+    std::vector<char> next;
+    {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [this]
+                { return pending.size() < MAX_PENDING_BUFFERS || error; });
+        if (error)
+            std::rethrow_exception(error);
+
+        buffer.resize(used);
+        pending.push_back(std::move(buffer));
+        if (!spare.empty())
+        {
+            next = std::move(spare.back());
+            spare.pop_back();
+        }
+    }
+    cv.notify_all();
+
+    buffer = std::move(next);
+    buffer.resize(capacity);
+    used = 0;
+}
+
+void ResultWriter::writeAll(const char *data, size_t size) const
+{
+    trace::Scope scope("write results", "io");
+    while (size > 0)
+    {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                // Non-blocking descriptor (e.g. a streaming socket), wait until it drains
+                pollfd request{fd, POLLOUT, 0};
+                int ready = ::poll(&request, 1, -1);
+                if (ready < 0 && errno != EINTR)
+                    throw std::system_error(errno, std::generic_category(), "Could not poll the result output");
+                if (ready > 0 && (request.revents & (POLLERR | POLLHUP | POLLNVAL)))
+                    throw std::runtime_error("Result output closed or failed");
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "Could not write results");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+void ResultWriter::run()
+{
+    trace::setThreadName("result writer");
+    std::unique_lock lock(mutex);
+    while (true)
+    {
+        cv.wait(lock, [this]
+                { return stopping || !pending.empty(); });
+        if (pending.empty())
+            return;
+
+        std::vector<char> chunk = std::move(pending.front());
+        pending.pop_front();
+        writing = true;
+        lock.unlock();
+
+        std::exception_ptr failure = nullptr;
+        try
+        {
+            writeAll(chunk.data(), chunk.size());
+        }
+        catch (...)
+        {
+            failure = std::current_exception();
+        }
+
+        lock.lock();
+        writing = false;
+        if (failure)
+        {
+            error = failure;
+            pending.clear();
+        }
+        spare.push_back(std::move(chunk));
+        cv.notify_all();
+    }
+}
+
+void ResultWriter::rethrow()
+{
+    if (!worker.joinable())
+        return;
+
+    std::lock_guard lock(mutex);
+    if (error)
+        std::rethrow_exception(error);
+}
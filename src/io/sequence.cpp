@@ -0,0 +1,58 @@
+#include <io/sequence.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+SequenceInfo parseSequenceInfo(const std::filesystem::path &iniPath)
+{
+    std::ifstream file(iniPath);
+    if (!file)
+        return {};
+
+    SequenceInfo info;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '[' || line[0] == ';')
+            continue;
+
+        auto eq = line.find('=');
+        if (eq == std::string::npos)
+            continue;
+
+        std::string key = line.substr(0, eq);
+        std::string val = line.substr(eq + 1);
+
+        auto trim = [](std::string &s)
+        {
+            s.erase(0, s.find_first_not_of(" \t\r\n"));
+            s.erase(s.find_last_not_of(" \t\r\n") + 1);
+        };
+        trim(key);
+        trim(val);
+
+        if (key == "imDir")
+            info.imDir = val;
+        else if (key == "frameRate")
+            info.frameRate = std::stod(val);
+        else if (key == "seqLength")
+            info.seqLength = std::stoi(val);
+        else if (key == "imWidth")
+            info.imWidth = std::stoi(val);
+        else if (key == "imHeight")
+            info.imHeight = std::stoi(val);
+    }
+    return info;
+}
+
+std::vector<std::filesystem::path> listSequences(const std::filesystem::path &splitPath)
+{
+    std::vector<std::filesystem::path> sequences;
+    for (const auto &entry : std::filesystem::directory_iterator(splitPath))
+    {
+        if (entry.is_directory())
+            sequences.push_back(entry.path());
+    }
+    std::sort(sequences.begin(), sequences.end());
+    return sequences;
+}
@@ -0,0 +1,306 @@
+#include <io/shm_ring.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring counters must be lock-free to live in shared memory");
+static_assert(sizeof(ShmDetection) == 32);
+
+namespace
+{
+    constexpr size_t SLOT_ALIGNMENT = 64;
+
+    size_t alignUp(size_t size)
+    {
+        return (size + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT * SLOT_ALIGNMENT;
+    }
+
+    struct SlotHeader
+    {
+        int32_t frame_id;
+        uint32_t count;
+        uint64_t published_ns;
+        uint64_t processed_ns;
+    };
+
+    size_t slotSize(uint32_t max_detections, uint32_t feature_dim)
+    {
+        return alignUp(sizeof(SlotHeader)) +
+               alignUp(max_detections * sizeof(ShmDetection)) +
+               alignUp(static_cast<size_t>(max_detections) * feature_dim * sizeof(float));
+    }
+
+    std::string segmentName(const std::string &name)
+    {
+        return name.starts_with('/') ? name : "/" + name;
+    }
+}
+
+// Counters sit on their own cache lines, the producer and consumer never write the same line
+struct ShmRing::Header
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t num_slots;
+    uint32_t max_detections;
+    uint32_t feature_dim;
+    uint64_t slot_size;
+    alignas(64) std::atomic<uint64_t> written;   // producer: published slots
+    alignas(64) std::atomic<uint64_t> processed; // consumer: completed slots
+    alignas(64) std::atomic<uint64_t> collected; // producer: slots read back and free
+    alignas(64) std::atomic<uint32_t> closed;
+    std::atomic<uint32_t> ready;
+};
+
+ShmRing ShmRing::create(const std::string &t_name, uint32_t num_slots, uint32_t max_detections, uint32_t feature_dim)
+{
+    if (num_slots == 0 || max_detections == 0)
+        throw std::invalid_argument("Ring needs at least one slot of one detection");
+
+    ShmRing ring;
+    ring.name = segmentName(t_name);
+    ring.owner = true;
+
+    size_t slot_size = slotSize(max_detections, feature_dim);
+    ring.length = alignUp(sizeof(Header)) + num_slots * slot_size;
+
+    int fd = ::shm_open(ring.name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), "Could not create shared memory " + ring.name);
+    if (::ftruncate(fd, static_cast<off_t>(ring.length)) < 0)
+    {
+        int error = errno;
+        ::close(fd);
+        ::shm_unlink(ring.name.c_str());
+        throw std::system_error(error, std::generic_category(), "Could not size shared memory " + ring.name);
+    }
+
+    ring.address = ::mmap(nullptr, ring.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int error = errno;
+    ::close(fd);
+    if (ring.address == MAP_FAILED)
+    {
+        ring.address = nullptr;
+        ::shm_unlink(ring.name.c_str());
+        throw std::system_error(error, std::generic_category(), "Could not map shared memory " + ring.name);
+    }
+
+    // The consumer only trusts the geometry once `ready` is set
+    auto *header = new (ring.address) Header{};
+    std::memcpy(header->magic, MAGIC, sizeof(MAGIC));
+    header->version = VERSION;
+    header->num_slots = num_slots;
+    header->max_detections = max_detections;
+    header->feature_dim = feature_dim;
+    header->slot_size = slot_size;
+    header->ready.store(1, std::memory_order_release);
+    return ring;
+}
+
+ShmRing ShmRing::open(const std::string &t_name)
+{
+    auto ring = tryOpen(t_name);
+    if (!ring)
+        throw std::runtime_error("Shared memory " + segmentName(t_name) + " is not initialised yet");
+    return std::move(*ring);
+}
+
+std::optional<ShmRing> ShmRing::tryOpen(const std::string &t_name)
+{
+    ShmRing ring;
+    ring.name = segmentName(t_name);
+
+    int fd = ::shm_open(ring.name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), "Could not open shared memory " + ring.name);
+
+    struct stat info{};
+    if (::fstat(fd, &info) < 0)
+    {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "Could not stat shared memory " + ring.name);
+    }
+    if (static_cast<size_t>(info.st_size) < sizeof(Header))
+    {
+        // Created, not sized yet
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    ring.length = static_cast<size_t>(info.st_size);
+    ring.address = ::mmap(nullptr, ring.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int error = errno;
+    ::close(fd);
+    if (ring.address == MAP_FAILED)
+    {
+        ring.address = nullptr;
+        throw std::system_error(error, std::generic_category(), "Could not map shared memory " + ring.name);
+    }
+
+    const auto *header = ring.header();
+    if (header->ready.load(std::memory_order_acquire) != 1)
+        return std::nullopt;
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION)
+        throw std::runtime_error("Shared memory " + ring.name + " is not a detection ring");
+    if (ring.length < alignUp(sizeof(Header)) + header->num_slots * header->slot_size)
+        throw std::runtime_error("Shared memory " + ring.name + " is truncated");
+
+    // Resume after whatever was already received by a previous consumer
+    ring.received = header->processed.load(std::memory_order_acquire);
+    return ring;
+}
+
+ShmRing::ShmRing(ShmRing &&other) noexcept
+    : name(std::move(other.name)),
+      owner(std::exchange(other.owner, false)),
+      address(std::exchange(other.address, nullptr)),
+      length(std::exchange(other.length, 0)),
+      received(other.received)
+{
+}
+
+ShmRing &ShmRing::operator=(ShmRing &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        name = std::move(other.name);
+        owner = std::exchange(other.owner, false);
+        address = std::exchange(other.address, nullptr);
+        length = std::exchange(other.length, 0);
+        received = other.received;
+    }
+    return *this;
+}
+
+ShmRing::~ShmRing()
+{
+    release();
+}
+
+void ShmRing::release()
+{
+    if (address)
+        ::munmap(address, length);
+    if (owner)
+        ::shm_unlink(name.c_str());
+    address = nullptr;
+    owner = false;
+}
+
+uint32_t ShmRing::getNumSlots() const { return header()->num_slots; }
+uint32_t ShmRing::getMaxDetections() const { return header()->max_detections; }
+uint32_t ShmRing::getFeatureDim() const { return header()->feature_dim; }
+
+char *ShmRing::slotBase(uint64_t sequence) const
+{
+    const auto *head = header();
+    return static_cast<char *>(address) + alignUp(sizeof(Header)) + (sequence % head->num_slots) * head->slot_size;
+}
+
+ShmFrame ShmRing::slot(uint64_t sequence, bool published) const
+{
+    const auto *head = header();
+    char *base = slotBase(sequence);
+    const auto *slot_header = reinterpret_cast<const SlotHeader *>(base);
+    auto *detections = reinterpret_cast<ShmDetection *>(base + alignUp(sizeof(SlotHeader)));
+    auto *features = reinterpret_cast<float *>(base + alignUp(sizeof(SlotHeader)) + alignUp(head->max_detections * sizeof(ShmDetection)));
+    size_t count = published ? slot_header->count : head->max_detections;
+
+    ShmFrame frame;
+    frame.sequence = sequence;
+    frame.frame_id = published ? slot_header->frame_id : 0;
+    frame.detections = {detections, count};
+    frame.features = {features, count * head->feature_dim};
+    frame.feature_dim = head->feature_dim;
+    frame.published_ns = published ? slot_header->published_ns : 0;
+    frame.processed_ns = published ? slot_header->processed_ns : 0;
+    return frame;
+}
+
+bool ShmRing::tryAcquire(ShmFrame &frame)
+{
+    auto *head = header();
+    uint64_t written = head->written.load(std::memory_order_relaxed);
+    if (written - head->collected.load(std::memory_order_relaxed) >= head->num_slots)
+        return false;
+
+    frame = slot(written, false);
+    return true;
+}
+
+void ShmRing::publish(ShmFrame &frame, size_t count)
+{
+    auto *head = header();
+    if (count > head->max_detections)
+        throw std::length_error("Frame has more detections than a ring slot holds");
+
+    auto *slot_header = reinterpret_cast<SlotHeader *>(slotBase(frame.sequence));
+    slot_header->frame_id = frame.frame_id;
+    slot_header->count = static_cast<uint32_t>(count);
+    slot_header->published_ns = now();
+    slot_header->processed_ns = 0;
+    frame.published_ns = slot_header->published_ns;
+
+    head->written.store(frame.sequence + 1, std::memory_order_release);
+}
+
+bool ShmRing::tryCollect(ShmFrame &frame)
+{
+    auto *head = header();
+    uint64_t collected = head->collected.load(std::memory_order_relaxed);
+    if (collected >= head->processed.load(std::memory_order_acquire))
+        return false;
+
+    frame = slot(collected, true);
+    head->collected.store(collected + 1, std::memory_order_relaxed);
+    return true;
+}
+
+void ShmRing::close()
+{
+    header()->closed.store(1, std::memory_order_release);
+}
+
+bool ShmRing::tryReceive(ShmFrame &frame)
+{
+    if (received >= header()->written.load(std::memory_order_acquire))
+        return false;
+
+    frame = slot(received++, true);
+    return true;
+}
+
+void ShmRing::complete(ShmFrame &frame)
+{
+    auto *slot_header = reinterpret_cast<SlotHeader *>(slotBase(frame.sequence));
+    slot_header->processed_ns = now();
+    frame.processed_ns = slot_header->processed_ns;
+
+    header()->processed.store(frame.sequence + 1, std::memory_order_release);
+}
+
+bool ShmRing::finished() const
+{
+    const auto *head = header();
+    return head->closed.load(std::memory_order_acquire) == 1 &&
+           received >= head->written.load(std::memory_order_acquire);
+}
+
+uint64_t ShmRing::now()
+{
+    timespec ts{};
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
@@ -0,0 +1,145 @@
+#include <io/stream_reader.hpp>
+#include <io/detection_file.hpp>
+#include <trace/trace.hpp>
+
+#include <cerrno>
+#include <string_view>
+#include <system_error>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+StreamReader::StreamReader(int t_fd) : fd(t_fd)
+{
+    original_flags = ::fcntl(fd, F_GETFL);
+    if (original_flags < 0 || ::fcntl(fd, F_SETFL, original_flags | O_NONBLOCK) < 0)
+        throw std::system_error(errno, std::generic_category(), "Could not make the input stream non-blocking");
+}
+
+StreamReader::~StreamReader()
+{
+    ::fcntl(fd, F_SETFL, original_flags);
+}
+
+bool StreamReader::poll(int timeout_ms)
+{
+    if (eof)
+        return false;
+
+    pollfd request{fd, POLLIN, 0};
+    int result = ::poll(&request, 1, timeout_ms);
+    if (result < 0)
+    {
+        if (errno == EINTR)
+            return true;
+        throw std::system_error(errno, std::generic_category(), "Could not poll the input stream");
+    }
+    if (result == 0)
+        return true;
+
+    // Drain everything available, the frames are split in one pass afterwards
+    char chunk[65536];
+    while (true)
+    {
+        ssize_t count = ::read(fd, chunk, sizeof(chunk));
+        if (count > 0)
+        {
+            buffer.append(chunk, static_cast<size_t>(count));
+            continue;
+        }
+        if (count == 0)
+        {
+            eof = true;
+            break;
+        }
+        if (errno == EINTR)
+            continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            break;
+        throw std::system_error(errno, std::generic_category(), "Could not read the input stream");
+    }
+
+    split(Clock::now());
+    return !eof;
+}
+
+void StreamReader::split(Clock::time_point now)
+{
+    trace::Scope scope("parse stream", "io");
+    while (true)
+    {
+        size_t eol = buffer.find('\n', parsed);
+        if (eol == std::string::npos)
+            break;
+
+        std::string_view line(buffer.data() + parsed, eol - parsed);
+        parsed = eol + 1;
+
+        if (isBlankLine(line))
+        {
+            // An empty line ends the frame, even one without detections
+            if (!in_frame)
+                current.received = now;
+            ready.push_back(std::move(current));
+            current = Frame{};
+            in_frame = false;
+            continue;
+        }
+
+        if (!in_frame)
+        {
+            current.received = now;
+            in_frame = true;
+        }
+
+        Detection det;
+        if (parseDetection(line, det))
+            current.detections.push_back(std::move(det));
+        else
+            skipped_lines++;
+    }
+
+    // Drop consumed bytes once they dominate the buffer
+    if (parsed > 0 && parsed >= buffer.size() / 2)
+    {
+        buffer.erase(0, parsed);
+        parsed = 0;
+    }
+
+    // A trailing frame without its terminator is flushed when the stream closes
+    if (eof)
+    {
+        std::string_view rest(buffer.data() + parsed, buffer.size() - parsed);
+        if (!isBlankLine(rest))
+        {
+            if (!in_frame)
+                current.received = now;
+            in_frame = true;
+            Detection det;
+            if (parseDetection(rest, det))
+                current.detections.push_back(std::move(det));
+            else
+                skipped_lines++;
+        }
+        buffer.clear();
+        parsed = 0;
+
+        if (in_frame)
+        {
+            ready.push_back(std::move(current));
+            current = Frame{};
+            in_frame = false;
+        }
+    }
+}
+
+bool StreamReader::nextFrame(Frame &frame)
+{
+    if (ready.empty())
+        return false;
+
+    frame = std::move(ready.front());
+    ready.pop_front();
+    return true;
+}
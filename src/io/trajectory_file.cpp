@@ -0,0 +1,24 @@
+#include <io/trajectory_file.hpp>
+
+#include <cstring>
+#include <stdexcept>
+
+static_assert(sizeof(TrajectoryHeader) == 16);
+static_assert(sizeof(TrajectoryRow) == 32);
+
+TrajectoryFile::TrajectoryFile(const std::filesystem::path &path) : file(path)
+{
+    TrajectoryHeader header{};
+    if (file.size() < sizeof(header))
+        throw std::runtime_error("Truncated trajectory file: " + path.string());
+
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC)) != 0)
+        throw std::runtime_error("Not a trajectory file: " + path.string());
+    if (header.version != TRAJECTORY_VERSION || header.row_size != sizeof(TrajectoryRow))
+        throw std::runtime_error("Unsupported trajectory file version: " + path.string());
+
+    // The header keeps the rows 16-byte aligned within the page-aligned mapping
+    size_t count = (file.size() - sizeof(header)) / sizeof(TrajectoryRow);
+    rows = {reinterpret_cast<const TrajectoryRow *>(file.data() + sizeof(header)), count};
+}
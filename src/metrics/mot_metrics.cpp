@@ -0,0 +1,515 @@
+#include <metrics/mot_metrics.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include <assignment/affinity.hpp>
+#include <assignment/hungarian.hpp>
+#include <parallel/thread_pool.hpp>
+
+namespace
+{
+    constexpr double EPS = 1e-10;
+
+    struct Entry
+    {
+        int frame;
+        int id; // compact, 0 .. number of ids - 1
+        cv::Rect2f box;
+    };
+
+    // Rows of one side sorted by frame, with ids renumbered from 0
+    struct Side
+    {
+        std::vector<Entry> entries{};
+        int num_ids = 0;
+
+        template <typename Keep>
+        Side(std::span<const Detection> rows, Keep &&keep)
+        {
+            std::unordered_map<int, int> ids;
+            entries.reserve(rows.size());
+            for (const auto &det : rows)
+            {
+                if (!keep(det))
+                    continue;
+                auto [it, inserted] = ids.try_emplace(det.track_id, num_ids);
+                if (inserted)
+                    num_ids++;
+                entries.push_back({det.frame_id, it->second, det.bbox});
+            }
+            std::stable_sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+                             { return a.frame < b.frame; });
+        }
+    };
+
+    struct Frame
+    {
+        std::span<const Entry> gt;
+        std::span<const Entry> hyp;
+        const float *iou; // gt.size() x hyp.size()
+    };
+
+    // Calls fn(index, frame) for every frame with ground truth or tracks, in order
+    template <typename F>
+    void forEachFrame(const Side &gt, const Side &hyp, F &&fn)
+    {
+        affinity::Boxes gt_boxes, hyp_boxes;
+        std::vector<float> iou;
+
+        size_t g = 0, h = 0;
+        for (int index = 0; g < gt.entries.size() || h < hyp.entries.size(); ++index)
+        {
+            int frame = std::min(g < gt.entries.size() ? gt.entries[g].frame : INT32_MAX,
+                                 h < hyp.entries.size() ? hyp.entries[h].frame : INT32_MAX);
+
+            size_t g_end = g, h_end = h;
+            gt_boxes.clear();
+            hyp_boxes.clear();
+            for (; g_end < gt.entries.size() && gt.entries[g_end].frame == frame; ++g_end)
+                gt_boxes.push_back(gt.entries[g_end].box);
+            for (; h_end < hyp.entries.size() && hyp.entries[h_end].frame == frame; ++h_end)
+                hyp_boxes.push_back(hyp.entries[h_end].box);
+
+            iou.resize(gt_boxes.size() * hyp_boxes.size());
+            affinity::iou(gt_boxes, 0, gt_boxes.size(), hyp_boxes, 0, hyp_boxes.size(), iou.data(), hyp_boxes.size());
+
+            fn(index, Frame{std::span(gt.entries).subspan(g, g_end - g),
+                            std::span(hyp.entries).subspan(h, h_end - h),
+                            iou.data()});
+            g = g_end;
+            h = h_end;
+        }
+    }
+
+    uint64_t pairKey(int gt_id, int hyp_id)
+    {
+        return (static_cast<uint64_t>(gt_id) << 32) | static_cast<uint32_t>(hyp_id);
+    }
+
+    // Square max-cost assignment of an n x m score matrix, zero padded
+    std::vector<long> assign(const std::vector<float> &scores, size_t rows, size_t cols)
+    {
+        const int n = static_cast<int>(std::max(rows, cols));
+        cv::Mat_<float> cost(n, n, 0.f);
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j)
+                cost(static_cast<int>(i), static_cast<int>(j)) = scores[i * cols + j];
+        return hungarian::max_cost_assignment(cost);
+    }
+
+    // Best one-to-one mapping between gt and hypothesis ids, maximising the number of
+    // frames they overlap. Ids only interact through overlapping pairs, so every connected
+    // component of the overlap graph is solved on its own.
+    size_t identityTruePositives(const std::unordered_map<uint64_t, uint32_t> &overlaps, int num_gt, int num_hyp)
+    {
+        std::vector<int> parent(static_cast<size_t>(num_gt + num_hyp));
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&](int x)
+        {
+            while (parent[x] != x)
+                x = parent[x] = parent[parent[x]];
+            return x;
+        };
+
+        for (const auto &[key, count] : overlaps)
+            parent[find(static_cast<int>(key >> 32))] = find(num_gt + static_cast<int>(key & 0xffffffff));
+
+        std::unordered_map<int, std::vector<std::pair<uint64_t, uint32_t>>> components;
+        for (const auto &pair : overlaps)
+            components[find(static_cast<int>(pair.first >> 32))].push_back(pair);
+
+        std::vector<int> local(parent.size(), -1);
+        std::vector<float> scores;
+        size_t idtp = 0;
+        for (const auto &[root, pairs] : components)
+        {
+            if (pairs.size() == 1)
+            {
+                idtp += pairs.front().second;
+                continue;
+            }
+
+            size_t rows = 0, cols = 0;
+            for (const auto &[key, count] : pairs)
+            {
+                int gt_id = static_cast<int>(key >> 32);
+                int hyp_id = num_gt + static_cast<int>(key & 0xffffffff);
+                if (local[gt_id] < 0)
+                    local[gt_id] = static_cast<int>(rows++);
+                if (local[hyp_id] < 0)
+                    local[hyp_id] = static_cast<int>(cols++);
+            }
+
+            scores.assign(rows * cols, 0.f);
+            for (const auto &[key, count] : pairs)
+                scores[local[key >> 32] * cols + local[num_gt + (key & 0xffffffff)]] = static_cast<float>(count);
+
+            auto assignment = assign(scores, rows, cols);
+            for (size_t i = 0; i < rows; ++i)
+                if (static_cast<size_t>(assignment[i]) < cols)
+                    idtp += static_cast<size_t>(scores[i * cols + assignment[i]]);
+
+            for (const auto &[key, count] : pairs)
+            {
+                local[key >> 32] = -1;
+                local[num_gt + (key & 0xffffffff)] = -1;
+            }
+        }
+        return idtp;
+    }
+
+    double ratio(double num, double den)
+    {
+        return den > 0. ? num / den : 0.;
+    }
+
+    template <typename F>
+    double thresholdMean(F &&fn)
+    {
+        double sum = 0.;
+        for (size_t a = 0; a < HOTA_THRESHOLDS; ++a)
+            sum += fn(a);
+        return sum / HOTA_THRESHOLDS;
+    }
+}
+
+MotMetrics evaluateMot(std::span<const Detection> gt_rows, std::span<const Detection> hyp_rows,
+                       const MetricsConfig &config, ThreadPool *pool)
+{
+    Side gt(gt_rows, [&](const Detection &det)
+            { return det.confidence >= config.min_gt_confidence; });
+    Side hyp(hyp_rows, [](const Detection &)
+             { return true; });
+
+    MotMetrics metrics;
+    metrics.gt_tracks = gt.num_ids;
+    metrics.gt_detections = gt.entries.size();
+    metrics.hyp_detections = hyp.entries.size();
+
+    const size_t num_gt = static_cast<size_t>(gt.num_ids);
+    const size_t num_hyp = static_cast<size_t>(hyp.num_ids);
+    const float threshold = config.iou_threshold;
+
+    // Per gt id CLEAR-MOT state
+    std::vector<int> last_hyp(num_gt, -1);
+    std::vector<int> last_matched(num_gt, -2); // frame index of the last match
+    std::vector<int> present(num_gt, 0), tracked(num_gt, 0);
+    std::vector<uint8_t> lost(num_gt, 0); // missed since the last match, for fragmentations
+
+    std::vector<int> hyp_column(num_hyp, -1);
+    std::vector<uint8_t> gt_used, hyp_used;
+    std::vector<size_t> rows, cols;
+    std::vector<float> scores, row_sum, col_sum;
+
+    // Identity overlaps and HOTA alignment potential per (gt, hyp) pair
+    std::unordered_map<uint64_t, uint32_t> overlaps;
+    std::unordered_map<uint64_t, double> alignment;
+    std::vector<int> hyp_present(num_hyp, 0);
+
+    // Pass 1: CLEAR-MOT matching (motmetrics MOTAccumulator), id overlaps, HOTA potentials
+    forEachFrame(gt, hyp, [&](int index, const Frame &frame)
+                 {
+        const size_t ng = frame.gt.size(), nh = frame.hyp.size();
+        metrics.frames++;
+
+        gt_used.assign(ng, 0);
+        hyp_used.assign(nh, 0);
+        for (size_t j = 0; j < nh; ++j)
+            hyp_column[frame.hyp[j].id] = static_cast<int>(j);
+
+        auto match = [&](size_t i, size_t j)
+        {
+            int o = frame.gt[i].id, h = frame.hyp[j].id;
+            gt_used[i] = hyp_used[j] = 1;
+            if (last_hyp[o] >= 0 && last_hyp[o] != h)
+                metrics.switches++;
+            last_hyp[o] = h;
+            last_matched[o] = index;
+            metrics.matches++;
+            metrics.distance += 1. - frame.iou[i * nh + j];
+        };
+
+        // Keep the correspondences of the previous frame while they still overlap
+        for (size_t i = 0; i < ng; ++i)
+        {
+            int o = frame.gt[i].id;
+            if (last_matched[o] != index - 1)
+                continue;
+            int j = hyp_column[last_hyp[o]];
+            if (j >= 0 && !hyp_used[j] && frame.iou[i * nh + j] >= threshold)
+                match(i, static_cast<size_t>(j));
+        }
+
+        // Minimum distance assignment of the rest, maximum number of matches first
+        rows.clear();
+        cols.clear();
+        for (size_t i = 0; i < ng; ++i)
+            if (!gt_used[i])
+                rows.push_back(i);
+        for (size_t j = 0; j < nh; ++j)
+            if (!hyp_used[j])
+                cols.push_back(j);
+
+        if (!rows.empty() && !cols.empty())
+        {
+            const float bonus = static_cast<float>(std::max(rows.size(), cols.size()));
+            scores.assign(rows.size() * cols.size(), 0.f);
+            bool any = false;
+            for (size_t r = 0; r < rows.size(); ++r)
+                for (size_t c = 0; c < cols.size(); ++c)
+                {
+                    float iou = frame.iou[rows[r] * nh + cols[c]];
+                    if (iou >= threshold)
+                    {
+                        scores[r * cols.size() + c] = bonus - (1.f - iou);
+                        any = true;
+                    }
+                }
+
+            if (any)
+            {
+                auto assignment = assign(scores, rows.size(), cols.size());
+                for (size_t r = 0; r < rows.size(); ++r)
+                {
+                    size_t c = static_cast<size_t>(assignment[r]);
+                    if (c < cols.size() && scores[r * cols.size() + c] > 0.f)
+                        match(rows[r], cols[c]);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < ng; ++i)
+        {
+            int o = frame.gt[i].id;
+            present[o]++;
+            if (gt_used[i])
+            {
+                tracked[o]++;
+                if (lost[o])
+                    metrics.fragmentations++;
+                lost[o] = 0;
+            }
+            else
+            {
+                metrics.misses++;
+                lost[o] = tracked[o] > 0;
+            }
+        }
+        for (size_t j = 0; j < nh; ++j)
+        {
+            if (!hyp_used[j])
+                metrics.false_positives++;
+            hyp_present[frame.hyp[j].id]++;
+            hyp_column[frame.hyp[j].id] = -1;
+        }
+
+        // Overlaps, and the HOTA potential: IoU normalised by the total similarity of its row and column
+        row_sum.assign(ng, 0.f);
+        col_sum.assign(nh, 0.f);
+        for (size_t i = 0; i < ng; ++i)
+            for (size_t j = 0; j < nh; ++j)
+            {
+                row_sum[i] += frame.iou[i * nh + j];
+                col_sum[j] += frame.iou[i * nh + j];
+            }
+
+        for (size_t i = 0; i < ng; ++i)
+            for (size_t j = 0; j < nh; ++j)
+            {
+                float iou = frame.iou[i * nh + j];
+                if (iou <= 0.f)
+                    continue;
+                uint64_t key = pairKey(frame.gt[i].id, frame.hyp[j].id);
+                if (iou >= threshold)
+                    overlaps[key]++;
+                double denominator = static_cast<double>(row_sum[i]) + col_sum[j] - iou;
+                if (denominator > EPS)
+                    alignment[key] += iou / denominator;
+            } });
+
+    for (size_t o = 0; o < num_gt; ++o)
+    {
+        double tracked_ratio = static_cast<double>(tracked[o]) / present[o];
+        if (tracked_ratio >= 0.8)
+            metrics.mostly_tracked++;
+        else if (tracked_ratio < 0.2)
+            metrics.mostly_lost++;
+        else
+            metrics.partially_tracked++;
+    }
+
+    metrics.idtp = identityTruePositives(overlaps, gt.num_ids, hyp.num_ids);
+
+    // Global alignment score of every overlapping pair (TrackEval HOTA)
+    for (auto &[key, potential] : alignment)
+        potential /= present[key >> 32] + hyp_present[key & 0xffffffff] - potential;
+
+    // Pass 2: per-frame HOTA matching, maximising alignment x similarity
+    struct Match
+    {
+        int gt;
+        int hyp;
+        float similarity;
+    };
+    std::vector<Match> hota_matches;
+
+    forEachFrame(gt, hyp, [&](int, const Frame &frame)
+                 {
+        const size_t ng = frame.gt.size(), nh = frame.hyp.size();
+        if (ng == 0 || nh == 0)
+            return;
+
+        scores.assign(ng * nh, 0.f);
+        for (size_t i = 0; i < ng; ++i)
+            for (size_t j = 0; j < nh; ++j)
+            {
+                float iou = frame.iou[i * nh + j];
+                if (iou > 0.f)
+                    scores[i * nh + j] = static_cast<float>(alignment[pairKey(frame.gt[i].id, frame.hyp[j].id)] * iou);
+            }
+
+        auto assignment = assign(scores, ng, nh);
+        for (size_t i = 0; i < ng; ++i)
+        {
+            size_t j = static_cast<size_t>(assignment[i]);
+            if (j < nh && frame.iou[i * nh + j] > 0.f)
+                hota_matches.push_back({frame.gt[i].id, frame.hyp[j].id, frame.iou[i * nh + j]});
+        } });
+
+    // Thresholds are independent
+    auto accumulate = [&](size_t a)
+    {
+        const double alpha = 0.05 * static_cast<double>(a + 1);
+        std::unordered_map<uint64_t, uint32_t> counts;
+        double tp = 0., loc = 0.;
+        for (const auto &match : hota_matches)
+        {
+            if (match.similarity < alpha - EPS)
+                continue;
+            counts[pairKey(match.gt, match.hyp)]++;
+            tp += 1.;
+            loc += match.similarity;
+        }
+
+        double ass = 0., ass_re = 0., ass_pr = 0.;
+        for (const auto &[key, count] : counts)
+        {
+            double c = count;
+            double gt_count = present[key >> 32];
+            double hyp_count = hyp_present[key & 0xffffffff];
+            ass += c * c / std::max(1., gt_count + hyp_count - c);
+            ass_re += c * c / std::max(1., gt_count);
+            ass_pr += c * c / std::max(1., hyp_count);
+        }
+
+        metrics.hota_tp[a] = tp;
+        metrics.hota_loc[a] = loc;
+        metrics.hota_ass[a] = ass;
+        metrics.hota_ass_re[a] = ass_re;
+        metrics.hota_ass_pr[a] = ass_pr;
+    };
+
+    if (pool)
+        pool->parallelFor(0, HOTA_THRESHOLDS, accumulate);
+    else
+        for (size_t a = 0; a < HOTA_THRESHOLDS; ++a)
+            accumulate(a);
+
+    return metrics;
+}
+
+MotMetrics &MotMetrics::operator+=(const MotMetrics &other)
+{
+    frames += other.frames;
+    gt_tracks += other.gt_tracks;
+    gt_detections += other.gt_detections;
+    hyp_detections += other.hyp_detections;
+    matches += other.matches;
+    switches += other.switches;
+    misses += other.misses;
+    false_positives += other.false_positives;
+    fragmentations += other.fragmentations;
+    distance += other.distance;
+    mostly_tracked += other.mostly_tracked;
+    partially_tracked += other.partially_tracked;
+    mostly_lost += other.mostly_lost;
+    idtp += other.idtp;
+    for (size_t a = 0; a < HOTA_THRESHOLDS; ++a)
+    {
+        hota_tp[a] += other.hota_tp[a];
+        hota_ass[a] += other.hota_ass[a];
+        hota_ass_re[a] += other.hota_ass_re[a];
+        hota_ass_pr[a] += other.hota_ass_pr[a];
+        hota_loc[a] += other.hota_loc[a];
+    }
+    return *this;
+}
+
+double MotMetrics::mota() const
+{
+    return gt_detections > 0 ? 1. - static_cast<double>(misses + false_positives + switches) / gt_detections : 0.;
+}
+
+double MotMetrics::motp() const { return ratio(distance, matches); }
+double MotMetrics::recall() const { return ratio(matches, gt_detections); }
+double MotMetrics::precision() const { return ratio(matches, hyp_detections); }
+
+double MotMetrics::idf1() const { return ratio(2. * idtp, gt_detections + hyp_detections); }
+double MotMetrics::idp() const { return ratio(idtp, hyp_detections); }
+double MotMetrics::idr() const { return ratio(idtp, gt_detections); }
+
+double MotMetrics::hota() const
+{
+    return thresholdMean([&](size_t a)
+                         {
+        double deta = hota_tp[a] / std::max(1., gt_detections + hyp_detections - hota_tp[a]);
+        double assa = hota_ass[a] / std::max(1., hota_tp[a]);
+        return std::sqrt(deta * assa); });
+}
+
+double MotMetrics::deta() const
+{
+    return thresholdMean([&](size_t a)
+                         { return hota_tp[a] / std::max(1., gt_detections + hyp_detections - hota_tp[a]); });
+}
+
+double MotMetrics::assa() const
+{
+    return thresholdMean([&](size_t a)
+                         { return hota_ass[a] / std::max(1., hota_tp[a]); });
+}
+
+double MotMetrics::loca() const
+{
+    return thresholdMean([&](size_t a)
+                         { return std::max(EPS, hota_loc[a]) / std::max(EPS, hota_tp[a]); });
+}
+
+double MotMetrics::detre() const
+{
+    return thresholdMean([&](size_t a)
+                         { return hota_tp[a] / std::max(1., static_cast<double>(gt_detections)); });
+}
+
+double MotMetrics::detpr() const
+{
+    return thresholdMean([&](size_t a)
+                         { return hota_tp[a] / std::max(1., static_cast<double>(hyp_detections)); });
+}
+
+double MotMetrics::assre() const
+{
+    return thresholdMean([&](size_t a)
+                         { return hota_ass_re[a] / std::max(1., hota_tp[a]); });
+}
+
+double MotMetrics::asspr() const
+{
+    return thresholdMean([&](size_t a)
+                         { return hota_ass_pr[a] / std::max(1., hota_tp[a]); });
+}
@@ -0,0 +1,181 @@
+#include <parallel/thread_pool.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <format>
+
+#include <trace/trace.hpp>
+
+namespace
+{
+    thread_local const ThreadPool *current_pool = nullptr;
+    thread_local size_t current_index = 0;
+}
+
+ThreadPool::ThreadPool(size_t num_threads)
+{
+    num_threads = std::max<size_t>(1, num_threads);
+
+    queues.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i)
+        queues.push_back(std::make_unique<Queue>());
+
+    workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i)
+        workers.emplace_back([this, i]()
+                             { run(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void ThreadPool::push(std::function<void()> task)
+{
+    // Keep work local to the submitting worker, otherwise spread it
+    size_t index = current_pool == this ? current_index : next_queue++ % queues.size();
+
+    // Counted before it becomes visible, so a concurrent pop() never takes `pending` below zero
+    pending++;
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+
+    // Synchronize with waiters checking `pending` before going to sleep
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+    }
+    cv.notify_one();
+}
+
+bool ThreadPool::pop(size_t index, std::function<void()> &task)
+{
+    // Own queue first, oldest task first
+    {
+        auto &queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            pending--;
+            return true;
+        }
+    }
+
+    // Steal from the back of the other queues
+    for (size_t k = 1; k < queues.size(); ++k)
+    {
+        auto &queue = *queues[(index + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            pending--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::run(size_t index)
+{
+    current_pool = this;
+    current_index = index;
+    trace::setThreadName(std::format("pool worker {}", index));
+
+    std::function<void()> task;
+    while (true)
+    {
+        if (pop(index, task))
+        {
+            trace::Scope scope("task", "pool");
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]()
+                { return stop || pending > 0; });
+        if (stop && pending == 0)
+            return;
+    }
+}
+
+void ThreadPool::parallelFor(size_t begin, size_t end, const std::function<void(size_t)> &fn, size_t grain)
+{
+    if (begin >= end)
+        return;
+
+    size_t count = end - begin;
+    size_t chunks = std::min(workers.size() + 1, (count + std::max<size_t>(1, grain) - 1) / std::max<size_t>(1, grain));
+    if (chunks <= 1)
+    {
+        for (size_t i = begin; i < end; ++i)
+            fn(i);
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::exception_ptr error = nullptr;
+    };
+
+    auto state = std::make_shared<State>();
+    size_t chunk_size = (count + chunks - 1) / chunks;
+
+    // Chunks are claimed dynamically, so a helper that starts late simply finds nothing left
+    auto work = [state, chunks, chunk_size, begin, end, &fn]()
+    {
+        size_t chunk;
+        while ((chunk = state->next++) < chunks)
+        {
+            size_t first = begin + chunk * chunk_size;
+            size_t last = std::min(end, first + chunk_size);
+            try
+            {
+                for (size_t i = first; i < last; ++i)
+                    fn(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error)
+                    state->error = std::current_exception();
+            }
+
+            if (++state->done == chunks)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    for (size_t k = 1; k < chunks; ++k)
+        push(work);
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&state, chunks]()
+                   { return state->done == chunks; });
+
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
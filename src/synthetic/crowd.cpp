@@ -0,0 +1,288 @@
+#include <synthetic/crowd.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <numbers>
+#include <stdexcept>
+
+#include <io/npy.hpp>
+#include <io/result_writer.hpp>
+
+CrowdGenerator::CrowdGenerator(const CrowdConfig &t_config) : config(t_config), state(t_config.seed)
+{
+    if (config.num_objects == 0 || config.density <= 0.f || config.min_height <= 0.f || config.max_height < config.min_height)
+        throw std::invalid_argument("CrowdGenerator: invalid object count, density or box size");
+
+    float area = static_cast<float>(config.num_objects) / config.density;
+    width = std::sqrt(area * config.aspect_ratio);
+    height = area / width;
+
+    // Embeddings: each identity leans towards a shared direction as separation drops
+    std::vector<float> shared(config.feature_dim), own(config.feature_dim);
+    randomUnit(shared);
+
+    const float start_occluded = std::clamp(config.occlusion_rate, 0.f, 1.f);
+    objects.resize(config.num_objects);
+    for (auto &object : objects)
+    {
+        float h = uniform(config.min_height, config.max_height);
+        float w = 0.4f * h;
+        object.box = cv::Rect2f(uniform(0.f, std::max(0.f, width - w)), uniform(0.f, std::max(0.f, height - h)), w, h);
+
+        float angle = uniform(0.f, 2.f * std::numbers::pi_v<float>);
+        float speed = config.speed * uniform(0.5f, 1.5f);
+        object.vx = speed * std::cos(angle);
+        object.vy = speed * std::sin(angle);
+        object.occluded = uniform() < start_occluded;
+
+        if (config.feature_dim > 0)
+        {
+            randomUnit(own);
+            object.identity.resize(config.feature_dim);
+            float norm = 0.f;
+            for (size_t k = 0; k < config.feature_dim; ++k)
+            {
+                object.identity[k] = config.identity_separation * own[k] + (1.f - config.identity_separation) * shared[k];
+                norm += object.identity[k] * object.identity[k];
+            }
+            norm = std::sqrt(norm);
+            for (auto &value : object.identity)
+                value /= norm;
+        }
+    }
+}
+
+float CrowdGenerator::uniform()
+{
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    return static_cast<float>(z >> 40) * 0x1.0p-24f; // [0, 1)
+}
+
+float CrowdGenerator::normal()
+{
+    // Box-Muller, one value per call
+    float u1 = std::max(uniform(), 1e-7f);
+    float u2 = uniform();
+    return std::sqrt(-2.f * std::log(u1)) * std::cos(2.f * std::numbers::pi_v<float> * u2);
+}
+
+void CrowdGenerator::randomUnit(std::vector<float> &vector)
+{
+    float norm = 0.f;
+    for (auto &value : vector)
+    {
+        value = normal();
+        norm += value * value;
+    }
+    norm = std::sqrt(norm);
+    for (auto &value : vector)
+        value /= norm;
+}
+
+void CrowdGenerator::embed(const std::vector<float> &identity, std::vector<float> &features)
+{
+    const float scale = config.feature_noise / std::sqrt(static_cast<float>(identity.size()));
+    features.resize(identity.size());
+    float norm = 0.f;
+    for (size_t k = 0; k < identity.size(); ++k)
+    {
+        features[k] = identity[k] + scale * normal();
+        norm += features[k] * features[k];
+    }
+    norm = std::sqrt(norm);
+    for (auto &value : features)
+        value /= norm;
+}
+
+void CrowdGenerator::move(Object &object)
+{
+    if (config.motion == MotionModel::RandomWalk)
+    {
+        object.vx += config.motion_noise * normal();
+        object.vy += config.motion_noise * normal();
+        float speed = std::hypot(object.vx, object.vy);
+        float max_speed = 3.f * config.speed;
+        if (speed > max_speed)
+        {
+            object.vx *= max_speed / speed;
+            object.vy *= max_speed / speed;
+        }
+    }
+
+    auto &box = object.box;
+    box.x += object.vx;
+    box.y += object.vy;
+
+    // Bounce off the borders, so the number of objects on the canvas stays constant
+    if (box.x < 0.f)
+    {
+        box.x = -box.x;
+        object.vx = std::abs(object.vx);
+    }
+    else if (box.x + box.width > width)
+    {
+        box.x = std::max(0.f, 2.f * (width - box.width) - box.x);
+        object.vx = -std::abs(object.vx);
+    }
+    if (box.y < 0.f)
+    {
+        box.y = -box.y;
+        object.vy = std::abs(object.vy);
+    }
+    else if (box.y + box.height > height)
+    {
+        box.y = std::max(0.f, 2.f * (height - box.height) - box.y);
+        object.vy = -std::abs(object.vy);
+    }
+}
+
+void CrowdGenerator::next(std::vector<Detection> &detections)
+{
+    step(detections, nullptr);
+}
+
+void CrowdGenerator::next(std::vector<Detection> &detections, std::vector<Detection> &ground_truth)
+{
+    step(detections, &ground_truth);
+}
+
+void CrowdGenerator::step(std::vector<Detection> &detections, std::vector<Detection> *ground_truth)
+{
+    frame++;
+
+    // Occlusions are episodes: the start probability gives `occlusion_rate` of hidden frames
+    // on average, the end probability `occlusion_length` frames per episode
+    const float rate = std::clamp(config.occlusion_rate, 0.f, 1.f);
+    const float length = std::max(1.f, config.occlusion_length);
+    const float end_occlusion = 1.f / length;
+    const float start_occlusion = rate < 1.f ? std::min(1.f, rate / (length * (1.f - rate))) : 1.f;
+
+    // Detections are reused in place, so their feature buffers keep their capacity
+    size_t count = 0;
+    auto slot = [&]() -> Detection &
+    {
+        if (count == detections.size())
+            detections.emplace_back();
+        return detections[count++];
+    };
+
+    if (ground_truth)
+        ground_truth->clear();
+
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        auto &object = objects[i];
+        move(object);
+
+        if (object.occluded)
+            object.occluded = uniform() >= end_occlusion;
+        else
+            object.occluded = uniform() < start_occlusion;
+
+        if (ground_truth)
+        {
+            Detection gt;
+            gt.frame_id = frame;
+            gt.track_id = static_cast<int>(i) + 1;
+            gt.class_id = 1;
+            gt.confidence = 1.f;
+            gt.bbox = object.box;
+            ground_truth->push_back(std::move(gt));
+        }
+
+        if (object.occluded || uniform() < config.miss_rate)
+            continue;
+
+        auto &det = slot();
+        det.frame_id = frame;
+        det.track_id = -1;
+        det.class_id = 1;
+        det.confidence = uniform(0.5f, 1.f);
+        det.bbox = cv::Rect2f(object.box.x + config.box_noise * normal(),
+                              object.box.y + config.box_noise * normal(),
+                              std::max(1.f, object.box.width + config.box_noise * normal()),
+                              std::max(1.f, object.box.height + config.box_noise * normal()));
+        if (config.feature_dim > 0)
+            embed(object.identity, det.features);
+        else
+            det.features.clear();
+    }
+
+    false_positive_budget += static_cast<double>(config.false_positive_rate) * static_cast<double>(objects.size());
+    auto false_positives = static_cast<size_t>(false_positive_budget);
+    false_positive_budget -= static_cast<double>(false_positives);
+    for (size_t k = 0; k < false_positives; ++k)
+    {
+        auto &det = slot();
+        float h = uniform(config.min_height, config.max_height);
+        det.frame_id = frame;
+        det.track_id = -1;
+        det.class_id = 1;
+        det.confidence = uniform(0.1f, 0.6f);
+        det.bbox = cv::Rect2f(uniform(0.f, width - 0.4f * h), uniform(0.f, height - h), 0.4f * h, h);
+        det.features.resize(config.feature_dim);
+        randomUnit(det.features);
+    }
+
+    detections.resize(count);
+}
+
+std::vector<cv::Rect2f> CrowdGenerator::getBoxes() const
+{
+    std::vector<cv::Rect2f> boxes;
+    boxes.reserve(objects.size());
+    for (const auto &object : objects)
+        boxes.push_back(object.box);
+    return boxes;
+}
+
+void writeCrowdSequence(const CrowdConfig &config, const std::filesystem::path &path, int frames)
+{
+    std::filesystem::create_directories(path / "det");
+    std::filesystem::create_directories(path / "gt");
+
+    CrowdGenerator generator(config);
+    {
+        std::ofstream ini(path / "seqinfo.ini");
+        ini << "[Sequence]\n"
+            << "name=" << path.filename().string() << "\n"
+            << "imDir=img1\n"
+            << "frameRate=30\n"
+            << "seqLength=" << frames << "\n"
+            << "imWidth=" << static_cast<int>(std::ceil(generator.getWidth())) << "\n"
+            << "imHeight=" << static_cast<int>(std::ceil(generator.getHeight())) << "\n"
+            << "imExt=.jpg\n";
+    }
+
+    ResultWriter det(path / "det/det.txt");
+    std::ofstream gt(path / "gt/gt.txt");
+    if (!gt.is_open())
+        throw std::runtime_error("Could not open " + (path / "gt/gt.txt").string());
+
+    std::vector<Detection> detections, ground_truth;
+    std::vector<float> features;
+    for (int f = 0; f < frames; ++f)
+    {
+        generator.next(detections, ground_truth);
+        det.write(detections);
+
+        for (size_t i = 0; i < ground_truth.size(); ++i)
+        {
+            const auto &box = ground_truth[i].bbox;
+            gt << std::format("{},{},{:.2f},{:.2f},{:.2f},{:.2f},1,1,{}\n", ground_truth[i].frame_id, ground_truth[i].track_id,
+                              box.x, box.y, box.width, box.height, generator.isVisible(i) ? 1 : 0);
+        }
+
+        for (const auto &d : detections)
+            features.insert(features.end(), d.features.begin(), d.features.end());
+    }
+    det.flush();
+
+    if (config.feature_dim > 0)
+        writeNpy(path / "det/det.npy", features, config.feature_dim);
+}
@@ -0,0 +1,250 @@
+#include <trace/trace.hpp>
+
+#include <array>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace trace
+{
+    namespace detail
+    {
+        std::atomic<bool> recording{false};
+    }
+
+    namespace
+    {
+        constexpr size_t CHUNK_EVENTS = 4096;
+
+        // Written by the owning thread only: events first, then the release store of
+        // `size` (or `next`) publishes them to write()
+        struct Chunk
+        {
+            std::array<Event, CHUNK_EVENTS> events;
+            std::atomic<size_t> size{0};
+            std::atomic<Chunk *> next{nullptr};
+        };
+
+        struct ThreadBuffer
+        {
+            int tid = 0;
+            std::string name{};
+            std::unique_ptr<Chunk> head = std::make_unique<Chunk>();
+            Chunk *tail = head.get();
+            size_t count = 0; // owner only
+            std::atomic<size_t> dropped{0};
+
+            ~ThreadBuffer()
+            {
+                Chunk *chunk = head.release();
+                while (chunk)
+                {
+                    Chunk *next = chunk->next.load(std::memory_order_relaxed);
+                    delete chunk;
+                    chunk = next;
+                }
+            }
+        };
+
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers{};
+            std::atomic<uint64_t> generation{0}; // bumped by clear(), threads then register again
+            std::atomic<size_t> max_events{0};
+            std::atomic<int64_t> epoch_ns{0};
+            bool has_epoch = false;
+            int next_tid = 1;
+        };
+
+        Registry &registry()
+        {
+            static Registry instance;
+            return instance;
+        }
+
+        struct LocalBuffer
+        {
+            std::shared_ptr<ThreadBuffer> buffer = nullptr;
+            uint64_t generation = 0;
+            std::string name{};
+        };
+
+        thread_local LocalBuffer local;
+
+        int64_t steadyNow()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        ThreadBuffer &threadBuffer()
+        {
+            auto &reg = registry();
+            uint64_t generation = reg.generation.load(std::memory_order_acquire);
+            if (!local.buffer || local.generation != generation)
+            {
+                auto buffer = std::make_shared<ThreadBuffer>();
+                std::lock_guard lock(reg.mutex);
+                buffer->tid = reg.next_tid++;
+                buffer->name = local.name;
+                reg.buffers.push_back(buffer);
+                local.buffer = std::move(buffer);
+                local.generation = generation;
+            }
+            return *local.buffer;
+        }
+    }
+
+    std::string escape(const std::string &text)
+    {
+        std::string escaped;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20)
+                escaped += c;
+        }
+        return escaped;
+    }
+
+    uint64_t detail::now()
+    {
+        return static_cast<uint64_t>(steadyNow() - registry().epoch_ns.load(std::memory_order_relaxed));
+    }
+
+    void detail::append(const Event &event)
+    {
+        auto &buffer = threadBuffer();
+        if (buffer.count >= registry().max_events.load(std::memory_order_relaxed))
+        {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        Chunk *chunk = buffer.tail;
+        size_t size = chunk->size.load(std::memory_order_relaxed);
+        if (size == CHUNK_EVENTS)
+        {
+            auto *next = new Chunk();
+            chunk->next.store(next, std::memory_order_release);
+            buffer.tail = chunk = next;
+            size = 0;
+        }
+        chunk->events[size] = event;
+        chunk->size.store(size + 1, std::memory_order_release);
+        buffer.count++;
+    }
+
+    void start(size_t max_events)
+    {
+        auto &reg = registry();
+        {
+            // Timestamps of one trace share the epoch of its first start()
+            std::lock_guard lock(reg.mutex);
+            if (!reg.has_epoch)
+            {
+                reg.epoch_ns.store(steadyNow(), std::memory_order_relaxed);
+                reg.has_epoch = true;
+            }
+        }
+        reg.max_events.store(max_events, std::memory_order_relaxed);
+        detail::recording.store(true, std::memory_order_release);
+    }
+
+    void stop()
+    {
+        detail::recording.store(false, std::memory_order_release);
+    }
+
+    void clear()
+    {
+        auto &reg = registry();
+        std::lock_guard lock(reg.mutex);
+        reg.buffers.clear();
+        reg.has_epoch = false;
+        reg.generation.fetch_add(1, std::memory_order_release);
+    }
+
+    void setThreadName(const std::string &name)
+    {
+        // Applied when the thread registers its buffer, so naming a thread costs nothing
+        // until it records
+        local.name = name;
+        if (local.buffer && local.generation == registry().generation.load(std::memory_order_acquire))
+        {
+            std::lock_guard lock(registry().mutex);
+            local.buffer->name = name;
+        }
+    }
+
+    size_t size()
+    {
+        auto &reg = registry();
+        std::lock_guard lock(reg.mutex);
+        size_t total = 0;
+        for (const auto &buffer : reg.buffers)
+            for (const Chunk *chunk = buffer->head.get(); chunk; chunk = chunk->next.load(std::memory_order_acquire))
+                total += chunk->size.load(std::memory_order_acquire);
+        return total;
+    }
+
+    size_t dropped()
+    {
+        auto &reg = registry();
+        std::lock_guard lock(reg.mutex);
+        size_t total = 0;
+        for (const auto &buffer : reg.buffers)
+            total += buffer->dropped.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    void write(const std::filesystem::path &path)
+    {
+        std::ofstream file(path);
+        if (!file.is_open())
+            throw std::runtime_error("Could not open trace file: " + path.string());
+
+        auto &reg = registry();
+        std::lock_guard lock(reg.mutex);
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        auto separator = [&]()
+        {
+            if (!first)
+                file << ",\n";
+            first = false;
+        };
+
+        for (const auto &buffer : reg.buffers)
+        {
+            if (!buffer->name.empty())
+            {
+                separator();
+                file << std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+                                    buffer->tid, escape(buffer->name));
+            }
+
+            for (const Chunk *chunk = buffer->head.get(); chunk; chunk = chunk->next.load(std::memory_order_acquire))
+            {
+                size_t size = chunk->size.load(std::memory_order_acquire);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const auto &event = chunk->events[i];
+                    separator();
+                    file << std::format("{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}}}",
+                                        event.name, event.category, event.start_ns / 1e3, event.duration_ns / 1e3, buffer->tid);
+                }
+            }
+        }
+        file << "\n]}\n";
+
+        if (!file)
+            throw std::runtime_error("Could not write trace file: " + path.string());
+    }
+}
@@ -0,0 +1,118 @@
+#include <tracking/batch.hpp>
+
+SortBatch::SortBatch(const SortConfig &config, size_t num_streams)
+{
+    trackers.reserve(num_streams);
+    for (size_t i = 0; i < num_streams; ++i)
+        trackers.push_back(std::make_unique<Sort>(config));
+}
+
+void SortBatch::setProfiler(std::shared_ptr<TrackerProfiler> t_profiler)
+{
+    profiler = std::move(t_profiler);
+    for (auto &tracker : trackers)
+        tracker->setProfiler(profiler);
+}
+
+MemoryReport SortBatch::getMemoryReport() const
+{
+    MemoryReport report;
+    for (const auto &tracker : trackers)
+        report += tracker->getMemoryReport();
+    report.scratch += det_boxes.capacityBytes() + track_boxes.capacityBytes() + batch.capacityBytes() +
+                      (det_offsets.capacity() + track_offsets.capacity() + problems.capacity()) * sizeof(size_t);
+    return report;
+}
+
+void SortBatch::update(std::vector<std::vector<Detection>> &detections)
+{
+    trace::Scope scope("SortBatch::update", "tracker");
+
+    if (detections.size() != trackers.size())
+        throw std::invalid_argument("SortBatch expects one detection vector per stream");
+
+    const size_t num_streams = trackers.size();
+
+    // Class-aware association partitions each stream on its own
+    if (trackers.empty() || trackers.front()->config.class_aware)
+    {
+        for (size_t s = 0; s < num_streams; ++s)
+            trackers[s]->update(detections[s]);
+        return;
+    }
+
+    // Propagate tracks
+    for (auto &tracker : trackers)
+    {
+        tracker->predict();
+    }
+
+    // Pack boxes of all streams
+    det_boxes.clear();
+    track_boxes.clear();
+    det_offsets.assign(num_streams + 1, 0);
+    track_offsets.assign(num_streams + 1, 0);
+    problems.assign(num_streams, NO_PROBLEM);
+    batch.clear();
+
+    for (size_t s = 0; s < num_streams; ++s)
+    {
+        for (const auto &det : detections[s])
+            det_boxes.push_back(det.bbox);
+        for (const auto &track : trackers[s]->tracks)
+            track_boxes.push_back(track->getBox());
+
+        det_offsets[s + 1] = det_boxes.size();
+        track_offsets[s + 1] = track_boxes.size();
+
+        size_t num_dets = det_offsets[s + 1] - det_offsets[s];
+        size_t num_tracks = track_offsets[s + 1] - track_offsets[s];
+        if (num_dets && num_tracks)
+        {
+            problems[s] = batch.add(static_cast<int>(std::max(num_dets, num_tracks)));
+            trackers[s]->profileMatrix(num_dets, num_tracks);
+        }
+    }
+
+    // Create cost matrices
+    {
+        StageTimer timer(profiler.get(), TrackerStage::Cost);
+        for (size_t s = 0; s < num_streams; ++s)
+        {
+            if (problems[s] == NO_PROBLEM)
+                continue;
+
+            size_t k = problems[s];
+            affinity::iou(det_boxes, det_offsets[s], det_offsets[s + 1],
+                          track_boxes, track_offsets[s], track_offsets[s + 1],
+                          batch.cost(k), static_cast<size_t>(batch.dim(k)));
+        }
+    }
+
+    // Solve linear assignments
+    {
+        StageTimer timer(profiler.get(), TrackerStage::Solve);
+        batch.solve();
+    }
+
+    // Update each stream
+    for (size_t s = 0; s < num_streams; ++s)
+    {
+        std::set<std::pair<size_t, size_t>> matches;
+        std::set<size_t> unmatched_detections;
+        std::set<size_t> unmatched_tracks;
+
+        auto &tracker = *trackers[s];
+        size_t k = problems[s];
+        if (k == NO_PROBLEM)
+            tracker.assign(nullptr, 0, nullptr, detections[s].size(), tracker.tracks.size(),
+                           tracker.config.match_thresh, matches, unmatched_detections, unmatched_tracks);
+        else
+            tracker.assign(batch.cost(k), static_cast<size_t>(batch.dim(k)), batch.assignment(k),
+                           detections[s].size(), tracker.tracks.size(),
+                           tracker.config.match_thresh, matches, unmatched_detections, unmatched_tracks);
+
+        tracker.commit(detections[s], matches, unmatched_detections, unmatched_tracks);
+        tracker.profileTracks();
+    }
+}
@@ -29,6 +29,13 @@ void BotSortTrack::update(Detection &det)
     BaseTrack::update(det);
 }
 
+void BotSortTrack::addMemory(MemoryReport &report) const
+{
+    BaseTrack::addMemory(report);
+    report.tracks += sizeof(BotSortTrack) - sizeof(BaseTrack);
+    report.features += features.capacity() * sizeof(float);
+}
+
 void BotSort::assign(std::vector<Detection *> &dets,
                      std::vector<BotSortTrack *> &trks,
                      float match_thresh,
@@ -38,6 +45,28 @@ void BotSort::assign(std::vector<Detection *> &dets,
                      std::set<size_t> &unmatched_detections,
                      std::set<size_t> &unmatched_tracks)
 {
+    if (!config.class_aware)
+    {
+        associate(dets, trks, match_thresh, proximity_thresh, appearance_thresh, matches, unmatched_detections, unmatched_tracks);
+        return;
+    }
+
+    assignByClass(
+        dets, trks,
+        [&](auto &part_dets, auto &part_trks, auto &part_matches, auto &part_unmatched_dets, auto &part_unmatched_trks)
+        { associate(part_dets, part_trks, match_thresh, proximity_thresh, appearance_thresh, part_matches, part_unmatched_dets, part_unmatched_trks); },
+        matches, unmatched_detections, unmatched_tracks);
+}
+
+void BotSort::associate(std::vector<Detection *> &dets,
+                        std::vector<BotSortTrack *> &trks,
+                        float match_thresh,
+                        float proximity_thresh,
+                        float appearance_thresh,
+                        std::set<std::pair<size_t, size_t>> &matches,
+                        std::set<size_t> &unmatched_detections,
+                        std::set<size_t> &unmatched_tracks)
+{
 
     // By default detections are unmatched
     for (size_t i = 0; i < dets.size(); ++i)
@@ -54,33 +83,44 @@ void BotSort::assign(std::vector<Detection *> &dets,
     if (trks.empty() || dets.empty())
         return;
 
-    // Create cost matrix
+    std::vector<cv::Rect2f> boxes(trks.size());
+    for (size_t j = 0; j < trks.size(); ++j)
+        boxes[j] = trks[j]->getBox();
+
+    profileMatrix(dets.size(), trks.size());
+
+    // Create cost matrix, rows are independent
     int size = static_cast<int>(std::max(dets.size(), trks.size()));
     cv::Mat_<float> cost_matrix(size, size, 0.f);
-
-    for (size_t i = 0; i < dets.size(); ++i)
     {
-        for (size_t j = 0; j < trks.size(); ++j)
-        {
-            // Compute IoU similiarity
-            float iou = getIoU(dets[i]->bbox, trks[j]->getBox());
-            float un = (dets[i]->bbox | trks[j]->getBox()).area();
-            float proximity = dets[i]->bbox.area() / un;
-
-            // Compute cosine similarity
-            float similiarity = 0.f;
-            if (!dets[i]->features.empty() && !trks[j]->features.empty() && proximity > proximity_thresh)
+        auto timer = profileStage(TrackerStage::Cost);
+        parallelFor(dets.size(), [&](size_t i)
+                    {
+            for (size_t j = 0; j < trks.size(); ++j)
             {
-                similiarity = cosineSimilarity(dets[i]->features, trks[j]->features);
-                similiarity = similiarity > appearance_thresh ? similiarity : 0.f;
-            }
-
-            cost_matrix(i, j) = std::max(iou, similiarity);
-        }
+                // Compute IoU similiarity
+                float iou = getIoU(dets[i]->bbox, boxes[j]);
+                float un = (dets[i]->bbox | boxes[j]).area();
+                float proximity = dets[i]->bbox.area() / un;
+
+                // Compute cosine similarity
+                float similiarity = 0.f;
+                if (!dets[i]->features.empty() && !trks[j]->features.empty() && proximity > proximity_thresh)
+                {
+                    similiarity = cosineSimilarity(dets[i]->features, trks[j]->features);
+                    similiarity = similiarity > appearance_thresh ? similiarity : 0.f;
+                }
+
+                cost_matrix(i, j) = std::max(iou, similiarity);
+            } });
     }
 
     // Solve linear assignment
-    std::vector<long> assignment = hungarian::max_cost_assignment(cost_matrix);
+    std::vector<long> assignment;
+    {
+        auto timer = profileStage(TrackerStage::Solve);
+        assignment = hungarian::max_cost_assignment(cost_matrix);
+    }
 
     // Find matches
     for (size_t i = 0; i < dets.size(); ++i)
@@ -94,8 +134,25 @@ void BotSort::assign(std::vector<Detection *> &dets,
     }
 }
 
+void BotSort::updateMatches(const std::set<std::pair<size_t, size_t>> &matches,
+                            std::vector<Detection *> &dets,
+                            std::vector<BotSortTrack *> &trks)
+{
+    // Every match touches its own track and detection
+    auto timer = profileStage(TrackerStage::Update);
+    std::vector<std::pair<size_t, size_t>> matched(matches.begin(), matches.end());
+    parallelFor(matched.size(), [&](size_t k)
+                {
+        auto *det = dets[matched[k].first];
+        auto *track = trks[matched[k].second];
+        track->update(*det);
+        det->track_id = track->id; });
+}
+
 void BotSort::update(std::vector<Detection> &detections)
 {
+    trace::Scope scope("BotSort::update", "tracker");
+
     // Detection bins
     std::vector<Detection *> high_score_detections{};
     std::vector<Detection *> low_score_detections{};
@@ -134,9 +191,10 @@ void BotSort::update(std::vector<Detection> &detections)
     }
 
     // Propagate tracks
-    for (auto &track : tracks)
     {
-        track->predict();
+        auto timer = profileStage(TrackerStage::Predict);
+        parallelFor(tracks.size(), [this](size_t i)
+                    { tracks[i]->predict(); });
     }
 
     // First association
@@ -144,21 +202,18 @@ void BotSort::update(std::vector<Detection> &detections)
     std::set<size_t> first_unmatched_detections;
     std::set<size_t> first_unmatched_tracks;
 
-    assign(high_score_detections,
-           active_tracks,
-           config.first_match_thresh,
-           config.proximity_thresh,
-           config.appearance_thresh,
-           first_matches,
-           first_unmatched_detections,
-           first_unmatched_tracks);
-
-    for (const auto &[det_idx, track_idx] : first_matches)
     {
-        auto *det = high_score_detections[det_idx];
-        auto *track = active_tracks[track_idx];
-        track->update(*det);
-        det->track_id = track->id;
+        trace::Scope association("first association", "tracker");
+        assign(high_score_detections,
+               active_tracks,
+               config.first_match_thresh,
+               config.proximity_thresh,
+               config.appearance_thresh,
+               first_matches,
+               first_unmatched_detections,
+               first_unmatched_tracks);
+
+        updateMatches(first_matches, high_score_detections, active_tracks);
     }
 
     for (const auto &track_idx : first_unmatched_tracks)
@@ -179,21 +234,18 @@ void BotSort::update(std::vector<Detection> &detections)
     std::set<size_t> second_unmatched_detections;
     std::set<size_t> second_unmatched_tracks;
 
-    assign(low_score_detections,
-           unmatched_tracks,
-           config.second_match_thresh,
-           0.f,
-           1.f,
-           second_matches,
-           second_unmatched_detections,
-           second_unmatched_tracks);
-
-    for (const auto &[det_idx, track_idx] : second_matches)
     {
-        auto *det = low_score_detections[det_idx];
-        auto *track = unmatched_tracks[track_idx];
-        track->update(*det);
-        det->track_id = track->id;
+        trace::Scope association("second association", "tracker");
+        assign(low_score_detections,
+               unmatched_tracks,
+               config.second_match_thresh,
+               0.f,
+               1.f,
+               second_matches,
+               second_unmatched_detections,
+               second_unmatched_tracks);
+
+        updateMatches(second_matches, low_score_detections, unmatched_tracks);
     }
 
     for (const auto &track_idx : second_unmatched_tracks)
@@ -214,21 +266,18 @@ void BotSort::update(std::vector<Detection> &detections)
     std::set<size_t> unconfirmed_unmatched_detections;
     std::set<size_t> unconfirmed_unmatched_tracks;
 
-    assign(unconfirmed_detections,
-           unconfirmed_tracks,
-           config.unconfirmed_match_thresh,
-           config.proximity_thresh,
-           config.appearance_thresh,
-           unconfirmed_matches,
-           unconfirmed_unmatched_detections,
-           unconfirmed_unmatched_tracks);
-
-    for (const auto &[det_idx, track_idx] : unconfirmed_matches)
     {
-        auto *det = unconfirmed_detections[det_idx];
-        auto *track = unconfirmed_tracks[track_idx];
-        track->update(*det);
-        det->track_id = track->id;
+        trace::Scope association("unconfirmed association", "tracker");
+        assign(unconfirmed_detections,
+               unconfirmed_tracks,
+               config.unconfirmed_match_thresh,
+               config.proximity_thresh,
+               config.appearance_thresh,
+               unconfirmed_matches,
+               unconfirmed_unmatched_detections,
+               unconfirmed_unmatched_tracks);
+
+        updateMatches(unconfirmed_matches, unconfirmed_detections, unconfirmed_tracks);
     }
 
     for (const auto &track_idx : unconfirmed_unmatched_tracks)
@@ -238,24 +287,38 @@ void BotSort::update(std::vector<Detection> &detections)
     }
 
     // Initialize new tracks
+    std::vector<Detection *> new_dets{};
     for (const auto &det_idx : unconfirmed_unmatched_detections)
     {
         auto *det = unconfirmed_detections[det_idx];
         if (det->confidence > config.new_track_thresh)
-        {
-            auto new_track = std::make_unique<BotSortTrack>(det->bbox, det->features, config.kalman);
-            tracks.push_back(std::move(new_track));
-        }
+            new_dets.push_back(det);
+    }
+
+    {
+        auto timer = profileStage(TrackerStage::Create);
+        std::vector<std::unique_ptr<BaseTrack>> new_tracks(new_dets.size());
+        parallelFor(new_dets.size(), [&](size_t k)
+                    {
+            auto new_track = std::make_unique<BotSortTrack>(new_dets[k]->bbox, new_dets[k]->features, config.kalman);
+            new_track->class_id = new_dets[k]->class_id;
+            new_tracks[k] = std::move(new_track); });
+        appendTracks(new_tracks);
     }
 
     // Remove old tracks
-    for (auto &track : lost_tracks)
     {
-        if (track->time_since_update > config.max_time_lost)
-            track->markRemoved();
+        auto timer = profileStage(TrackerStage::Prune);
+        for (auto &track : lost_tracks)
+        {
+            if (track->time_since_update > config.max_time_lost)
+                track->markRemoved();
+        }
+
+        tracks.erase(std::remove_if(tracks.begin(), tracks.end(), [](const auto &track)
+                                    { return track->isRemoved(); }),
+                     tracks.end());
     }
 
-    tracks.erase(std::remove_if(tracks.begin(), tracks.end(), [](const auto &track)
-                                { return track->isRemoved(); }),
-                 tracks.end());
+    profileTracks();
 }
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include <tracking/multistream.hpp>
+#include <tracking/factory.hpp>
+
+MultiStreamTracker::MultiStreamTracker(const std::string &config_file, size_t num_streams, size_t num_threads)
+    : pool(num_threads)
+{
+    streams.reserve(num_streams);
+    for (size_t i = 0; i < num_streams; ++i)
+    {
+        auto stream = std::make_unique<Stream>();
+        stream->tracker = TrackerFactory::create(config_file);
+        streams.push_back(std::move(stream));
+    }
+}
+
+MultiStreamTracker::MultiStreamTracker(std::vector<std::unique_ptr<BaseTracker>> trackers, size_t num_threads)
+    : pool(num_threads)
+{
+    streams.reserve(trackers.size());
+    for (auto &tracker : trackers)
+    {
+        if (!tracker)
+            throw std::invalid_argument("MultiStreamTracker requires non-null trackers");
+
+        auto stream = std::make_unique<Stream>();
+        stream->tracker = std::move(tracker);
+        streams.push_back(std::move(stream));
+    }
+}
+
+MultiStreamTracker::~MultiStreamTracker()
+{
+    wait();
+}
+
+std::future<std::vector<Detection>> MultiStreamTracker::submit(size_t stream_id, std::vector<Detection> detections)
+{
+    auto &stream = *streams.at(stream_id);
+
+    Job job{std::move(detections), {}, Clock::now()};
+    auto result = job.result.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        in_flight++;
+    }
+
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(stream.mutex);
+        stream.jobs.push_back(std::move(job));
+        if (!stream.scheduled)
+        {
+            stream.scheduled = true;
+            schedule = true;
+        }
+    }
+
+    // At most one task per stream is in the pool, which preserves frame ordering
+    if (schedule)
+        pool.submit([this, &stream]()
+                    { process(stream); });
+
+    return result;
+}
+
+void MultiStreamTracker::process(Stream &stream)
+{
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(stream.mutex);
+        job = std::move(stream.jobs.front());
+        stream.jobs.pop_front();
+    }
+
+    std::exception_ptr error = nullptr;
+    auto start = Clock::now();
+    try
+    {
+        stream.tracker->update(job.detections);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    auto end = Clock::now();
+
+    bool reschedule = false;
+    {
+        std::lock_guard<std::mutex> lock(stream.mutex);
+
+        double update_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        double latency_ms = std::chrono::duration<double, std::milli>(end - job.submitted).count();
+
+        auto &stats = stream.stats;
+        stats.frames++;
+        stream.total_update_ms += update_ms;
+        stream.total_latency_ms += latency_ms;
+        stats.last_latency_ms = latency_ms;
+        stats.max_latency_ms = std::max(stats.max_latency_ms, latency_ms);
+        stats.mean_latency_ms = stream.total_latency_ms / static_cast<double>(stats.frames);
+        stats.mean_update_ms = stream.total_update_ms / static_cast<double>(stats.frames);
+
+        // One frame per task keeps streams fair, the next frame goes back to the pool
+        if (stream.jobs.empty())
+            stream.scheduled = false;
+        else
+            reschedule = true;
+    }
+
+    if (reschedule)
+        pool.submit([this, &stream]()
+                    { process(stream); });
+
+    // Publish the result last so that the stats are up to date once the future is ready
+    if (error)
+        job.result.set_exception(error);
+    else
+        job.result.set_value(std::move(job.detections));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--in_flight == 0)
+            idle.notify_all();
+    }
+}
+
+void MultiStreamTracker::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]()
+              { return in_flight == 0; });
+}
+
+StreamStats MultiStreamTracker::getStats(size_t stream_id) const
+{
+    const auto &stream = *streams.at(stream_id);
+    std::lock_guard<std::mutex> lock(stream.mutex);
+    return stream.stats;
+}
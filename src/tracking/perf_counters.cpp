@@ -0,0 +1,103 @@
+#include <tracking/perf_counters.hpp>
+
+#include <cerrno>
+#include <system_error>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+const std::array<PerfEvent, NUM_PERF_COUNTERS> PerfCounters::HARDWARE = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+}};
+
+PerfCounters::PerfCounters(std::span<const PerfEvent, NUM_PERF_COUNTERS> events)
+{
+    for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i)
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = events[i].type;
+        attr.config = events[i].config;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.disabled = i == 0; // the leader starts the whole group
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds[0], 0);
+        if (fd < 0)
+        {
+            int error = errno;
+            for (size_t k = 0; k < i; ++k)
+                close(fds[k]);
+            throw std::system_error(error, std::generic_category(), "perf_event_open");
+        }
+        fds[i] = static_cast<int>(fd);
+    }
+
+    ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (int fd : fds)
+        if (fd >= 0)
+            close(fd);
+}
+
+PerfCounters::Group PerfCounters::readGroup() const
+{
+    Group group{};
+    if (::read(fds[0], &group, sizeof(group)) != static_cast<ssize_t>(sizeof(group)))
+        throw std::system_error(errno, std::generic_category(), "Could not read perf counters");
+    return group;
+}
+
+PerfValues PerfCounters::read() const
+{
+    // Multiplexed with other groups: extrapolate to the time the group was enabled
+    Group group = readGroup();
+    PerfValues values{};
+    for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i)
+    {
+        values[i] = group.values[i];
+        if (group.time_running > 0 && group.time_running < group.time_enabled)
+            values[i] = static_cast<uint64_t>(static_cast<double>(values[i]) *
+                                              static_cast<double>(group.time_enabled) / static_cast<double>(group.time_running));
+    }
+    return values;
+}
+
+bool PerfCounters::scheduled() const
+{
+    return readGroup().time_running > 0;
+}
+
+#else
+
+const std::array<PerfEvent, NUM_PERF_COUNTERS> PerfCounters::HARDWARE = {};
+
+PerfCounters::PerfCounters(std::span<const PerfEvent, NUM_PERF_COUNTERS>)
+{
+    throw std::system_error(ENOSYS, std::generic_category(), "perf_event_open is Linux only");
+}
+
+PerfCounters::~PerfCounters() = default;
+
+PerfValues PerfCounters::read() const
+{
+    return {};
+}
+
+bool PerfCounters::scheduled() const
+{
+    return false;
+}
+
+#endif
@@ -0,0 +1,255 @@
+#include <tracking/profiler.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <memory>
+#include <system_error>
+
+namespace
+{
+    // Counter group of the current thread, reopened when a profiler asks for other events
+    struct ThreadCounters
+    {
+        std::array<PerfEvent, NUM_PERF_COUNTERS> events{};
+        std::unique_ptr<PerfCounters> counters = nullptr;
+        bool failed = false;
+    };
+
+    thread_local ThreadCounters thread_counters;
+
+    bool sameEvents(const std::array<PerfEvent, NUM_PERF_COUNTERS> &a, const std::array<PerfEvent, NUM_PERF_COUNTERS> &b)
+    {
+        for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i)
+            if (a[i].type != b[i].type || a[i].config != b[i].config)
+                return false;
+        return true;
+    }
+}
+
+static void atomicMax(std::atomic<uint64_t> &target, uint64_t value)
+{
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+// Values below 8 get a bucket each, then a power of two 2^e is split in 4 by the two
+// bits below the leading one
+size_t LatencyHistogram::bucketOf(uint64_t ns)
+{
+    if (ns < 8)
+        return static_cast<size_t>(ns);
+    size_t exponent = static_cast<size_t>(std::bit_width(ns)) - 1;
+    size_t sub = static_cast<size_t>(ns >> (exponent - 2)) & (SUB_BUCKETS - 1);
+    return std::min((exponent - 1) * SUB_BUCKETS + sub, NUM_BUCKETS - 1);
+}
+
+double LatencyHistogram::upperBound(size_t bucket)
+{
+    if (bucket < 8)
+        return static_cast<double>(bucket + 1);
+    size_t exponent = bucket / SUB_BUCKETS + 1;
+    size_t sub = bucket % SUB_BUCKETS;
+    return std::ldexp(static_cast<double>(SUB_BUCKETS + sub + 1), static_cast<int>(exponent) - 2);
+}
+
+void LatencyHistogram::record(uint64_t ns)
+{
+    buckets[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+    total_count.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(ns, std::memory_order_relaxed);
+    atomicMax(max_ns, ns);
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    total_count.store(0, std::memory_order_relaxed);
+    total_ns.store(0, std::memory_order_relaxed);
+    max_ns.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const
+{
+    uint64_t n = count();
+    return n ? static_cast<double>(total_ns.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.;
+}
+
+double LatencyHistogram::quantile(double q) const
+{
+    uint64_t n = count();
+    if (n == 0)
+        return 0.;
+
+    auto rank = static_cast<uint64_t>(std::ceil(std::clamp(q, 0., 1.) * static_cast<double>(n)));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+    {
+        seen += buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return std::min(upperBound(bucket), static_cast<double>(max()));
+    }
+    return static_cast<double>(max());
+}
+
+void TrackerProfiler::record(TrackerStage stage, uint64_t ns)
+{
+    stages[static_cast<size_t>(stage)].latency.record(ns);
+}
+
+void TrackerProfiler::recordMatrix(TrackerStage stage, size_t rows, size_t cols)
+{
+    auto &entry = stages[static_cast<size_t>(stage)];
+    entry.matrices.fetch_add(1, std::memory_order_relaxed);
+    entry.cells.fetch_add(rows * cols, std::memory_order_relaxed);
+    atomicMax(entry.max_rows, rows);
+    atomicMax(entry.max_cols, cols);
+}
+
+void TrackerProfiler::recordTracks(uint64_t t_tracked, uint64_t t_lost, uint64_t t_unconfirmed)
+{
+    frames.fetch_add(1, std::memory_order_relaxed);
+    tracked.store(t_tracked, std::memory_order_relaxed);
+    lost.store(t_lost, std::memory_order_relaxed);
+    unconfirmed.store(t_unconfirmed, std::memory_order_relaxed);
+    atomicMax(max_tracks, t_tracked + t_lost + t_unconfirmed);
+}
+
+void TrackerProfiler::reset()
+{
+    for (auto &entry : stages)
+    {
+        entry.latency.reset();
+        entry.matrices.store(0, std::memory_order_relaxed);
+        entry.cells.store(0, std::memory_order_relaxed);
+        entry.max_rows.store(0, std::memory_order_relaxed);
+        entry.max_cols.store(0, std::memory_order_relaxed);
+        entry.counted.store(0, std::memory_order_relaxed);
+        for (auto &counter : entry.counters)
+            counter.store(0, std::memory_order_relaxed);
+    }
+    frames.store(0, std::memory_order_relaxed);
+    tracked.store(0, std::memory_order_relaxed);
+    lost.store(0, std::memory_order_relaxed);
+    unconfirmed.store(0, std::memory_order_relaxed);
+    max_tracks.store(0, std::memory_order_relaxed);
+}
+
+bool TrackerProfiler::enableCounters(std::span<const PerfEvent, NUM_PERF_COUNTERS> events)
+{
+    std::copy(events.begin(), events.end(), counter_events.begin());
+
+    // Probe on the calling thread, other threads open their group on first use
+    try
+    {
+        PerfCounters probe(events);
+        volatile uint64_t work = 0;
+        for (uint64_t i = 0; i < 100000; ++i)
+            work = work + i;
+        if (!probe.scheduled())
+        {
+            counter_error = "perf counters opened but never scheduled, the PMU is in use "
+                            "(NMI watchdog, another perf session) or not virtualised";
+            counters_enabled.store(false, std::memory_order_relaxed);
+            return false;
+        }
+        probe.read();
+    }
+    catch (const std::system_error &e)
+    {
+        counter_error = e.what();
+        counters_enabled.store(false, std::memory_order_relaxed);
+        return false;
+    }
+
+    counter_error.clear();
+    counters_enabled.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+bool TrackerProfiler::readCounters(PerfValues &values) const
+{
+    auto &local = thread_counters;
+    if (!local.counters || !sameEvents(local.events, counter_events))
+    {
+        if (local.failed && sameEvents(local.events, counter_events))
+            return false;
+
+        local.events = counter_events;
+        local.counters = nullptr;
+        try
+        {
+            local.counters = std::make_unique<PerfCounters>(counter_events);
+            local.failed = false;
+        }
+        catch (const std::system_error &)
+        {
+            local.failed = true;
+            return false;
+        }
+    }
+
+    try
+    {
+        values = local.counters->read();
+    }
+    catch (const std::system_error &)
+    {
+        return false;
+    }
+    return true;
+}
+
+void TrackerProfiler::recordCounters(TrackerStage stage, const PerfValues &begin, const PerfValues &end)
+{
+    auto &entry = stages[static_cast<size_t>(stage)];
+    entry.counted.fetch_add(1, std::memory_order_relaxed);
+    // Multiplexed counts are estimates and may go backwards slightly
+    for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i)
+        entry.counters[i].fetch_add(end[i] > begin[i] ? end[i] - begin[i] : 0, std::memory_order_relaxed);
+}
+
+StageStats TrackerProfiler::getStats(TrackerStage stage) const
+{
+    const auto &entry = stages[static_cast<size_t>(stage)];
+    StageStats stats;
+    stats.count = entry.latency.count();
+    stats.mean_us = entry.latency.mean() / 1e3;
+    stats.p50_us = entry.latency.quantile(0.5) / 1e3;
+    stats.p99_us = entry.latency.quantile(0.99) / 1e3;
+    stats.max_us = static_cast<double>(entry.latency.max()) / 1e3;
+
+    stats.matrices = entry.matrices.load(std::memory_order_relaxed);
+    if (stats.matrices)
+        stats.mean_cells = static_cast<double>(entry.cells.load(std::memory_order_relaxed)) / static_cast<double>(stats.matrices);
+    stats.max_rows = entry.max_rows.load(std::memory_order_relaxed);
+    stats.max_cols = entry.max_cols.load(std::memory_order_relaxed);
+
+    uint64_t counted = entry.counted.load(std::memory_order_relaxed);
+    if (counted)
+    {
+        auto mean = [&](size_t i)
+        { return static_cast<double>(entry.counters[i].load(std::memory_order_relaxed)) / static_cast<double>(counted); };
+        stats.has_counters = true;
+        stats.cycles = mean(0);
+        stats.instructions = mean(1);
+        stats.cache_misses = mean(2);
+        stats.branch_misses = mean(3);
+    }
+    return stats;
+}
+
+TrackCounts TrackerProfiler::getTrackCounts() const
+{
+    TrackCounts counts;
+    counts.frames = frames.load(std::memory_order_relaxed);
+    counts.tracked = tracked.load(std::memory_order_relaxed);
+    counts.lost = lost.load(std::memory_order_relaxed);
+    counts.unconfirmed = unconfirmed.load(std::memory_order_relaxed);
+    counts.max_total = max_tracks.load(std::memory_order_relaxed);
+    return counts;
+}
@@ -0,0 +1,211 @@
+#include <tracking/recorder.hpp>
+#include <trace/trace.hpp>
+
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+static_assert(std::endian::native == std::endian::little, "Recordings are little-endian");
+static_assert(sizeof(RecordingHeader) == 16);
+static_assert(sizeof(UpdateHeader) == 24);
+static_assert(sizeof(RecordedRow) == 32);
+
+namespace
+{
+    template <typename T>
+    void append(std::vector<char> &buffer, const T *values, size_t count)
+    {
+        const char *bytes = reinterpret_cast<const char *>(values);
+        buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    int64_t nanoseconds(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    }
+}
+
+RecordingTracker::RecordingTracker(std::unique_ptr<BaseTracker> t_tracker, const std::filesystem::path &path)
+    : tracker(std::move(t_tracker)), file(path, std::ios::binary | std::ios::trunc), start(Clock::now())
+{
+    if (!tracker)
+        throw std::invalid_argument("RecordingTracker requires a tracker");
+    if (!file.is_open())
+        throw std::runtime_error("Could not open " + path.string());
+
+    RecordingHeader header{};
+    std::memcpy(header.magic, RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    header.version = RECORDING_VERSION;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (!file)
+        throw std::runtime_error("Could not write " + path.string());
+}
+
+void RecordingTracker::update(std::vector<Detection> &detections)
+{
+    // Inputs are serialized before the update, which may change them
+    UpdateHeader header{};
+    header.num_detections = static_cast<uint32_t>(detections.size());
+    buffer.resize(sizeof(UpdateHeader));
+    for (const auto &det : detections)
+    {
+        RecordedRow row{det.frame_id, det.class_id, det.confidence,
+                        det.bbox.x, det.bbox.y, det.bbox.width, det.bbox.height,
+                        static_cast<uint32_t>(det.features.size())};
+        append(buffer, &row, 1);
+        header.num_features += row.feature_dim;
+    }
+    for (const auto &det : detections)
+        append(buffer, det.features.data(), det.features.size());
+
+    auto begin = Clock::now();
+    tracker->update(detections);
+    auto end = Clock::now();
+
+    trace::Scope scope("record update", "io");
+    header.timestamp_ns = static_cast<uint64_t>(nanoseconds(begin - start));
+    header.update_ns = static_cast<uint64_t>(nanoseconds(end - begin));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    for (const auto &det : detections)
+    {
+        int32_t id = det.track_id;
+        append(buffer, &id, 1);
+    }
+
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!file)
+        throw std::runtime_error("Could not write the update recording");
+    num_updates++;
+}
+
+void RecordingTracker::flush()
+{
+    file.flush();
+    if (!file)
+        throw std::runtime_error("Could not write the update recording");
+}
+
+RecordingReader::RecordingReader(const std::filesystem::path &path) : file(path)
+{
+    RecordingHeader header{};
+    if (file.size() < sizeof(header))
+        throw std::runtime_error("Truncated recording: " + path.string());
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0)
+        throw std::runtime_error("Not a tracker recording: " + path.string());
+    if (header.version != RECORDING_VERSION)
+        throw std::runtime_error("Unsupported recording version " + std::to_string(header.version) + ": " + path.string());
+}
+
+bool RecordingReader::next(RecordedUpdate &update)
+{
+    const char *base = file.data();
+    size_t remaining = file.size() - offset;
+    if (remaining == 0)
+        return false;
+
+    UpdateHeader header{};
+    if (remaining < sizeof(header))
+    {
+        is_truncated = true;
+        return false;
+    }
+    std::memcpy(&header, base + offset, sizeof(header));
+
+    size_t rows_size = static_cast<size_t>(header.num_detections) * sizeof(RecordedRow);
+    size_t size = sizeof(header) + rows_size + static_cast<size_t>(header.num_features) * sizeof(float) +
+                  static_cast<size_t>(header.num_detections) * sizeof(int32_t);
+    if (remaining < size)
+    {
+        is_truncated = true;
+        return false;
+    }
+
+    // Sections are not aligned: copy instead of casting
+    const char *rows = base + offset + sizeof(header);
+    const char *features = rows + rows_size;
+    const char *ids = features + static_cast<size_t>(header.num_features) * sizeof(float);
+
+    update.timestamp_ns = header.timestamp_ns;
+    update.update_ns = header.update_ns;
+    update.detections.resize(header.num_detections);
+    update.track_ids.resize(header.num_detections);
+
+    size_t feature_offset = 0;
+    for (size_t i = 0; i < header.num_detections; ++i)
+    {
+        RecordedRow row{};
+        std::memcpy(&row, rows + i * sizeof(RecordedRow), sizeof(row));
+        if (feature_offset + row.feature_dim > header.num_features)
+            throw std::runtime_error("Corrupt recording: feature count mismatch");
+
+        auto &det = update.detections[i];
+        det.frame_id = row.frame_id;
+        det.track_id = -1;
+        det.class_id = row.class_id;
+        det.confidence = row.confidence;
+        det.bbox = cv::Rect2f(row.x, row.y, row.w, row.h);
+        det.features.resize(row.feature_dim);
+        std::memcpy(det.features.data(), features + feature_offset * sizeof(float), row.feature_dim * sizeof(float));
+        feature_offset += row.feature_dim;
+
+        int32_t id = 0;
+        std::memcpy(&id, ids + i * sizeof(int32_t), sizeof(id));
+        update.track_ids[i] = id;
+    }
+
+    offset += size;
+    return true;
+}
+
+ReplayResult replayRecording(const std::filesystem::path &path, BaseTracker &tracker, const ReplayOptions &options)
+{
+    RecordingReader reader(path);
+    ReplayResult result;
+
+    // Renaming of ids in both directions, see the header
+    std::unordered_map<int, int> replayed_of;
+    std::unordered_map<int, int> recorded_of;
+    auto consistent = [&](int recorded, int replayed)
+    {
+        if (recorded < 0 || replayed < 0)
+            return recorded < 0 && replayed < 0;
+        auto forward = replayed_of.try_emplace(recorded, replayed).first;
+        auto backward = recorded_of.try_emplace(replayed, recorded).first;
+        return forward->second == replayed && backward->second == recorded;
+    };
+
+    RecordedUpdate update;
+    auto replay_start = std::chrono::steady_clock::now();
+    while (reader.next(update))
+    {
+        if (options.realtime)
+            std::this_thread::sleep_until(replay_start + std::chrono::nanoseconds(update.timestamp_ns));
+
+        auto begin = std::chrono::steady_clock::now();
+        tracker.update(update.detections);
+        auto elapsed = std::chrono::steady_clock::now() - begin;
+
+        result.recorded_ms.push_back(static_cast<double>(update.update_ns) / 1e6);
+        result.replayed_ms.push_back(std::chrono::duration<double, std::milli>(elapsed).count());
+
+        size_t mismatched = 0;
+        for (size_t i = 0; i < update.detections.size(); ++i)
+            if (!consistent(update.track_ids[i], update.detections[i].track_id))
+                mismatched++;
+
+        if (mismatched)
+        {
+            if (result.first_mismatch < 0)
+                result.first_mismatch = static_cast<long>(result.updates);
+            result.mismatched_updates++;
+            result.mismatched_ids += mismatched;
+        }
+        result.updates++;
+        result.detections += update.detections.size();
+    }
+    result.truncated = reader.truncated();
+    return result;
+}
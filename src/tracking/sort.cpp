@@ -18,48 +18,117 @@ void SortTrack::update(Detection &det)
     BaseTrack::update(det);
 }
 
+void Sort::predict()
+{
+    auto timer = profileStage(TrackerStage::Predict);
+    parallelFor(tracks.size(), [this](size_t i)
+                { tracks[i]->predict(); });
+}
+
 void Sort::assign(std::vector<Detection> &detections,
                   float match_thresh,
                   std::set<std::pair<size_t, size_t>> &matches,
                   std::set<size_t> &unmatched_detections,
                   std::set<size_t> &unmatched_tracks)
 {
+    std::vector<Detection *> dets{};
+    dets.reserve(detections.size());
+    for (auto &det : detections)
+        dets.push_back(&det);
 
-    // By default detections are unmatched
-    for (size_t i = 0; i < detections.size(); ++i)
-    {
-        unmatched_detections.insert(i);
-    }
+    std::vector<BaseTrack *> trks{};
+    trks.reserve(tracks.size());
+    for (auto &track : tracks)
+        trks.push_back(track.get());
 
-    // By default tracks are unmatched
-    for (size_t i = 0; i < tracks.size(); ++i)
+    if (!config.class_aware)
     {
-        unmatched_tracks.insert(i);
+        associate(dets, trks, match_thresh, matches, unmatched_detections, unmatched_tracks);
+        return;
     }
 
-    if (tracks.empty() || detections.empty())
+    assignByClass(
+        dets, trks,
+        [this, match_thresh](auto &part_dets, auto &part_trks, auto &part_matches, auto &part_unmatched_dets, auto &part_unmatched_trks)
+        { associate(part_dets, part_trks, match_thresh, part_matches, part_unmatched_dets, part_unmatched_trks); },
+        matches, unmatched_detections, unmatched_tracks);
+}
+
+void Sort::associate(std::vector<Detection *> &dets,
+                     std::vector<BaseTrack *> &trks,
+                     float match_thresh,
+                     std::set<std::pair<size_t, size_t>> &matches,
+                     std::set<size_t> &unmatched_detections,
+                     std::set<size_t> &unmatched_tracks)
+{
+    if (trks.empty() || dets.empty())
     {
+        assign(nullptr, 0, nullptr, dets.size(), trks.size(), match_thresh, matches, unmatched_detections, unmatched_tracks);
         return;
     }
 
-    // Create cost matrix
-    int size = static_cast<int>(std::max(detections.size(), tracks.size()));
+    std::vector<cv::Rect2f> boxes(trks.size());
+    for (size_t j = 0; j < trks.size(); ++j)
+        boxes[j] = trks[j]->getBox();
+
+    profileMatrix(dets.size(), trks.size());
+
+    // Create cost matrix, rows are independent
+    int size = static_cast<int>(std::max(dets.size(), trks.size()));
     cv::Mat_<float> cost_matrix(size, size, 0.f);
-    for (size_t i = 0; i < detections.size(); ++i)
     {
-        for (size_t j = 0; j < tracks.size(); ++j)
-        {
-            cost_matrix(i, j) = getIoU(detections[i].bbox, tracks[j]->getBox());
-        }
+        auto timer = profileStage(TrackerStage::Cost);
+        parallelFor(dets.size(), [&](size_t i)
+                    {
+            for (size_t j = 0; j < trks.size(); ++j)
+            {
+                cost_matrix(i, j) = getIoU(dets[i]->bbox, boxes[j]);
+            } });
     }
 
     // Solve linear assignment
-    std::vector<long> assignment = hungarian::max_cost_assignment(cost_matrix);
+    std::vector<long> assignment;
+    {
+        auto timer = profileStage(TrackerStage::Solve);
+        assignment = hungarian::max_cost_assignment(cost_matrix);
+    }
+
+    assign(cost_matrix[0], size, assignment.data(), dets.size(), trks.size(), match_thresh, matches, unmatched_detections, unmatched_tracks);
+}
+
+// Collects the matches of an already solved square cost block (row-major, `stride` floats per row).
+// A null cost means there was nothing to solve and everything stays unmatched.
+void Sort::assign(const float *cost,
+                  size_t stride,
+                  const long *assignment,
+                  size_t num_detections,
+                  size_t num_tracks,
+                  float match_thresh,
+                  std::set<std::pair<size_t, size_t>> &matches,
+                  std::set<size_t> &unmatched_detections,
+                  std::set<size_t> &unmatched_tracks)
+{
+    // By default detections are unmatched
+    for (size_t i = 0; i < num_detections; ++i)
+    {
+        unmatched_detections.insert(i);
+    }
+
+    // By default tracks are unmatched
+    for (size_t i = 0; i < num_tracks; ++i)
+    {
+        unmatched_tracks.insert(i);
+    }
+
+    if (!cost)
+    {
+        return;
+    }
 
     // Find matches
-    for (size_t i = 0; i < detections.size(); ++i)
+    for (size_t i = 0; i < num_detections; ++i)
     {
-        if (cost_matrix(i, assignment[i]) < match_thresh)
+        if (cost[i * stride + assignment[i]] < match_thresh)
             continue;
 
         unmatched_detections.erase(i);
@@ -70,33 +139,53 @@ void Sort::assign(std::vector<Detection> &detections,
 
 void Sort::update(std::vector<Detection> &detections)
 {
+    trace::Scope scope("Sort::update", "tracker");
+
     std::set<std::pair<size_t, size_t>> matches;
     std::set<size_t> unmatched_detections;
     std::set<size_t> unmatched_tracks;
 
     // Propagate tracks
-    for (auto &track : tracks)
-    {
-        track->predict();
-    }
+    predict();
 
     // Assign detections to tracks
     assign(detections, config.match_thresh, matches, unmatched_detections, unmatched_tracks);
 
-    // Update tracks
-    for (const auto &[det_idx, track_idx] : matches)
+    commit(detections, matches, unmatched_detections, unmatched_tracks);
+
+    profileTracks();
+}
+
+void Sort::commit(std::vector<Detection> &detections,
+                  const std::set<std::pair<size_t, size_t>> &matches,
+                  const std::set<size_t> &unmatched_detections,
+                  const std::set<size_t> &unmatched_tracks)
+{
+    // Update tracks, every match touches its own track and detection
     {
-        tracks[track_idx]->update(detections[det_idx]);
-        detections[det_idx].track_id = tracks[track_idx]->id;
+        auto timer = profileStage(TrackerStage::Update);
+        std::vector<std::pair<size_t, size_t>> matched(matches.begin(), matches.end());
+        parallelFor(matched.size(), [&](size_t k)
+                    {
+            const auto &[det_idx, track_idx] = matched[k];
+            tracks[track_idx]->update(detections[det_idx]);
+            detections[det_idx].track_id = tracks[track_idx]->id; });
     }
 
     // Create new tracks
-    for (const auto &det_idx : unmatched_detections)
     {
-        auto new_track = std::make_unique<SortTrack>(detections[det_idx].bbox, config.kalman);
-        tracks.push_back(std::move(new_track));
+        auto timer = profileStage(TrackerStage::Create);
+        std::vector<size_t> new_dets(unmatched_detections.begin(), unmatched_detections.end());
+        std::vector<std::unique_ptr<BaseTrack>> new_tracks(new_dets.size());
+        parallelFor(new_dets.size(), [&](size_t k)
+                    {
+            auto new_track = std::make_unique<SortTrack>(detections[new_dets[k]].bbox, config.kalman);
+            new_track->class_id = detections[new_dets[k]].class_id;
+            new_tracks[k] = std::move(new_track); });
+        appendTracks(new_tracks);
     }
 
+    auto timer = profileStage(TrackerStage::Prune);
     for (const auto &track_idx : unmatched_tracks)
     {
         if (tracks[track_idx]->time_since_update > config.max_time_lost)
@@ -0,0 +1,216 @@
+#include <tracking/tiled.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+TiledTracker::TiledTracker(const TilingConfig &t_config, TrackerBuilder t_builder)
+    : config(t_config), builder(std::move(t_builder))
+{
+    if (config.tile_width <= 0.f || config.tile_height <= 0.f)
+        throw std::invalid_argument("Tile size must be positive");
+    if (config.overlap < 0.f || 2.f * config.overlap >= std::min(config.tile_width, config.tile_height))
+        throw std::invalid_argument("Tile overlap must be smaller than half a tile");
+    if (!builder)
+        throw std::invalid_argument("TiledTracker requires a tracker builder");
+
+    size_t num_threads = config.num_threads ? config.num_threads : std::thread::hardware_concurrency();
+    if (num_threads > 1)
+        setThreadPool(std::make_shared<ThreadPool>(num_threads));
+}
+
+TiledTracker::Tile &TiledTracker::getTile(int col, int row)
+{
+    auto &tile = tiles[{col, row}];
+    if (!tile)
+    {
+        tile = std::make_unique<Tile>();
+        tile->tracker = builder();
+    }
+    return *tile;
+}
+
+MemoryReport TiledTracker::getMemoryReport() const
+{
+    MemoryReport report;
+    for (const auto &[key, tile] : tiles)
+    {
+        report += tile->tracker->getMemoryReport();
+        report.scratch += sizeof(Tile) + tile->detections.capacity() * sizeof(Detection);
+        for (const auto &det : tile->detections)
+            report.scratch += det.features.capacity() * sizeof(float);
+        // Node per entry plus the bucket array
+        report.scratch += tile->global_ids.size() * (sizeof(std::pair<const int, int>) + sizeof(void *)) +
+                          tile->global_ids.bucket_count() * sizeof(void *);
+    }
+    return report;
+}
+
+// Tiles draw ids for their new tracks concurrently from the shared counter. The ids
+// drawn are handed back out in tile order, then creation order within a tile, so that
+// numbering does not depend on thread timing.
+void TiledTracker::renumberNewTracks(const std::vector<Tile *> &active, int64_t first_new)
+{
+    std::vector<BaseTrack *> created;
+    std::vector<int> ids;
+    for (auto *tile : active)
+    {
+        size_t begin = created.size();
+        for (const auto &track : tile->tracker->getTracks())
+        {
+            if (track->id >= first_new)
+                created.push_back(track.get());
+        }
+        std::sort(created.begin() + static_cast<long>(begin), created.end(), [](const BaseTrack *a, const BaseTrack *b)
+                  { return a->id < b->id; });
+    }
+    if (created.empty())
+        return;
+
+    for (const auto *track : created)
+        ids.push_back(track->id);
+    std::sort(ids.begin(), ids.end());
+
+    std::unordered_map<int, int> renamed;
+    for (size_t k = 0; k < created.size(); ++k)
+    {
+        renamed.emplace(created[k]->id, ids[k]);
+        created[k]->id = ids[k];
+    }
+    for (auto *tile : active)
+    {
+        for (auto &det : tile->detections)
+        {
+            auto it = renamed.find(det.track_id);
+            if (it != renamed.end())
+                det.track_id = it->second;
+        }
+    }
+}
+
+void TiledTracker::update(std::vector<Detection> &detections)
+{
+    trace::Scope scope("TiledTracker::update", "tracker");
+
+    for (auto &[key, tile] : tiles)
+    {
+        tile->detections.clear();
+    }
+
+    // Route detections: owner tile first, then every neighbour whose margin contains the center
+    std::vector<std::vector<std::pair<Tile *, size_t>>> observers(detections.size());
+    for (size_t i = 0; i < detections.size(); ++i)
+    {
+        const auto &bbox = detections[i].bbox;
+        float cx = bbox.x + bbox.width / 2.f;
+        float cy = bbox.y + bbox.height / 2.f;
+        int col = static_cast<int>(std::floor(cx / config.tile_width));
+        int row = static_cast<int>(std::floor(cy / config.tile_height));
+
+        auto route = [&](int c, int r)
+        {
+            auto &tile = getTile(c, r);
+            Detection det = detections[i];
+            det.track_id = -1;
+            observers[i].emplace_back(&tile, tile.detections.size());
+            tile.detections.push_back(std::move(det));
+        };
+
+        route(col, row);
+        for (int dr = -1; dr <= 1; ++dr)
+        {
+            for (int dc = -1; dc <= 1; ++dc)
+            {
+                if (dr == 0 && dc == 0)
+                    continue;
+
+                float left = (col + dc) * config.tile_width - config.overlap;
+                float top = (row + dr) * config.tile_height - config.overlap;
+                float right = left + config.tile_width + 2.f * config.overlap;
+                float bottom = top + config.tile_height + 2.f * config.overlap;
+                if (cx >= left && cx < right && cy >= top && cy < bottom)
+                    route(col + dc, row + dr);
+            }
+        }
+    }
+
+    // Track every tile independently, including tiles without detections so their tracks age
+    std::vector<Tile *> active;
+    active.reserve(tiles.size());
+    for (auto &[key, tile] : tiles)
+        active.push_back(tile.get());
+
+    if (pool && active.size() > 1)
+    {
+        int64_t first_new = BaseTrack::count.load() + 1;
+        pool->parallelFor(0, active.size(), [&active](size_t t)
+                          { active[t]->tracker->update(active[t]->detections); });
+        renumberNewTracks(active, first_new);
+    }
+    else
+    {
+        for (auto *tile : active)
+            tile->tracker->update(tile->detections);
+    }
+
+    // Reconcile ids: keep the first known global id, owner tile first, so that
+    // a track entering a new tile through the overlap hands over its id. A local
+    // track can drift onto another object while its id is handed over elsewhere:
+    // the later detection claiming an id already assigned this frame gets a fresh one.
+    std::unordered_set<int> assigned;
+    std::vector<std::pair<Tile *, int>> locals;
+    for (size_t i = 0; i < detections.size(); ++i)
+    {
+        locals.clear();
+        for (const auto &[tile, k] : observers[i])
+        {
+            int local_id = tile->detections[k].track_id;
+            if (local_id > 0)
+                locals.emplace_back(tile, local_id);
+        }
+        if (locals.empty())
+            continue;
+
+        int global_id = -1;
+        for (const auto &[tile, local_id] : locals)
+        {
+            auto it = tile->global_ids.find(local_id);
+            if (it != tile->global_ids.end())
+            {
+                global_id = it->second;
+                break;
+            }
+        }
+        if (global_id < 0)
+            global_id = locals.front().second;
+        if (!assigned.insert(global_id).second)
+        {
+            global_id = BaseTrack::getNextId();
+            assigned.insert(global_id);
+        }
+
+        for (const auto &[tile, local_id] : locals)
+            tile->global_ids.insert_or_assign(local_id, global_id);
+
+        detections[i].track_id = global_id;
+    }
+
+    // Forget removed local tracks and drop empty tiles
+    for (auto it = tiles.begin(); it != tiles.end();)
+    {
+        auto &tile = *it->second;
+        const auto &local_tracks = tile.tracker->getTracks();
+        if (local_tracks.empty())
+        {
+            it = tiles.erase(it);
+            continue;
+        }
+
+        std::unordered_set<int> alive;
+        for (const auto &track : local_tracks)
+            alive.insert(track->id);
+        std::erase_if(tile.global_ids, [&alive](const auto &entry)
+                      { return !alive.contains(entry.first); });
+        ++it;
+    }
+}
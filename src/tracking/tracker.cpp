@@ -1,6 +1,7 @@
 #include <tracking/tracker.hpp>
+#include <algorithm>
 
-int64_t BaseTrack::count = 0;
+std::atomic<int64_t> BaseTrack::count = 0;
 
 BaseTrack::BaseTrack(std::shared_ptr<BaseKalmanFilter> kalman_filter)
     : kf(kalman_filter)
@@ -40,4 +41,57 @@ cv::Rect2f BaseTrack::getBox() const
 cv::Point2f BaseTrack::getVelocity() const
 {
     return kf->getVelocity();
+}
+
+void BaseTrack::addMemory(MemoryReport &report) const
+{
+    report.num_tracks++;
+    report.tracks += sizeof(BaseTrack);
+    report.history += history.capacity() * sizeof(cv::Rect2f);
+    if (kf)
+        report.filters += SHARED_CONTROL_BLOCK + kf->getMemoryBytes();
+}
+
+MemoryReport BaseTracker::getMemoryReport() const
+{
+    MemoryReport report;
+    report.tracks += tracks.capacity() * sizeof(std::unique_ptr<BaseTrack>);
+    for (const auto &track : tracks)
+        track->addMemory(report);
+    return report;
+}
+
+// Appends tracks that may have been constructed concurrently. Their ids are handed
+// back out in creation order so that numbering does not depend on thread timing.
+void BaseTracker::appendTracks(std::vector<std::unique_ptr<BaseTrack>> &new_tracks)
+{
+    std::vector<int> ids;
+    ids.reserve(new_tracks.size());
+    for (const auto &track : new_tracks)
+        ids.push_back(track->id);
+    std::sort(ids.begin(), ids.end());
+
+    tracks.reserve(tracks.size() + new_tracks.size());
+    for (size_t k = 0; k < new_tracks.size(); ++k)
+    {
+        new_tracks[k]->id = ids[k];
+        tracks.push_back(std::move(new_tracks[k]));
+    }
+    new_tracks.clear();
+}
+
+// Reports the track list by state, at the end of an update
+void BaseTracker::countTracks() const
+{
+    uint64_t tracked = 0, lost = 0, unconfirmed = 0;
+    for (const auto &track : tracks)
+    {
+        if (track->isActive())
+            tracked++;
+        else if (track->isLost())
+            lost++;
+        else if (track->state == TrackState::New)
+            unconfirmed++;
+    }
+    profiler->recordTracks(tracked, lost, unconfirmed);
 }
\ No newline at end of file
@@ -0,0 +1,300 @@
+#!/usr/bin/env python3
+"""Reference metrics of the gt.txt / res.txt fixture, checked by test_metrics.cpp.
+
+    pip install -r requirements.txt
+    python reference.py > expected.txt
+
+scores the fixture with motmetrics (CLEAR-MOT and IDF1, as eval_motchallenge) and
+TrackEval (HOTA). Without the packages, `--port` runs a pure Python transcription of
+the same algorithms: motmetrics 1.4 MOTAccumulator / id_global_assignment and
+TrackEval HOTA.eval_sequence.
+"""
+
+import argparse
+import math
+import os
+from collections import defaultdict
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+GT = os.path.join(HERE, 'gt.txt')
+RES = os.path.join(HERE, 'res.txt')
+IOU_THRESHOLD = 0.5
+ALPHAS = [0.05 * (i + 1) for i in range(19)]
+
+
+def load(path, min_confidence):
+    """{frame: [(id, x, y, w, h)]}, rows below min_confidence dropped"""
+    frames = defaultdict(list)
+    with open(path) as f:
+        for line in f:
+            v = line.strip().split(',')
+            if len(v) < 7 or float(v[6]) < min_confidence:
+                continue
+            frames[int(v[0])].append((int(v[1]), float(v[2]), float(v[3]), float(v[4]), float(v[5])))
+    return frames
+
+
+def iou(a, b):
+    ix = max(0., min(a[0] + a[2], b[0] + b[2]) - max(a[0], b[0]))
+    iy = max(0., min(a[1] + a[3], b[1] + b[3]) - max(a[1], b[1]))
+    inter = ix * iy
+    union = a[2] * a[3] + b[2] * b[3] - inter
+    return inter / union if union > 0 else 0.
+
+
+def assign(costs):
+    """Min-cost assignment of a rectangular matrix, (row, col) pairs (Kuhn-Munkres)"""
+    if not costs or not costs[0]:
+        return []
+    transposed = len(costs) > len(costs[0])
+    if transposed:
+        costs = [list(c) for c in zip(*costs)]
+    n, m = len(costs), len(costs[0])
+    inf = float('inf')
+    u, v = [0.] * (n + 1), [0.] * (m + 1)
+    p, way = [0] * (m + 1), [0] * (m + 1)
+    for i in range(1, n + 1):
+        p[0] = i
+        j0 = 0
+        minv = [inf] * (m + 1)
+        used = [False] * (m + 1)
+        while True:
+            used[j0] = True
+            i0, delta, j1 = p[j0], inf, 0
+            for j in range(1, m + 1):
+                if not used[j]:
+                    cur = costs[i0 - 1][j - 1] - u[i0] - v[j]
+                    if cur < minv[j]:
+                        minv[j], way[j] = cur, j0
+                    if minv[j] < delta:
+                        delta, j1 = minv[j], j
+            for j in range(m + 1):
+                if used[j]:
+                    u[p[j]] += delta
+                    v[j] -= delta
+                else:
+                    minv[j] -= delta
+            j0 = j1
+            if p[j0] == 0:
+                break
+        while j0:
+            j1 = way[j0]
+            p[j0] = p[j1]
+            j0 = j1
+    pairs = [(p[j] - 1, j - 1) for j in range(1, m + 1) if p[j]]
+    return sorted((c, r) for r, c in pairs) if transposed else sorted(pairs)
+
+
+def assign_feasible(dists):
+    """motmetrics lap: maximum number of finite pairs first, then minimum distance"""
+    finite = [d for row in dists for d in row if d is not None]
+    if not finite:
+        return []
+    big = (min(len(dists), len(dists[0])) + 1) * (max(abs(d) for d in finite) + 1)
+    costs = [[big if d is None else d for d in row] for row in dists]
+    return [(i, j) for i, j in assign(costs) if dists[i][j] is not None]
+
+
+def clear_mot_port(gt, res):
+    m = {}           # object -> hypothesis of its last match
+    last_match = {}  # object -> frame of its last match
+    last_frame = None
+    events = []      # (frame, type, object, hypothesis, distance)
+    overlaps = defaultdict(int)
+
+    for frame in sorted(set(gt) | set(res)):
+        objs, hyps = gt.get(frame, []), res.get(frame, [])
+        dists = []
+        for o in objs:
+            row = []
+            for h in hyps:
+                d = 1. - iou(o[1:], h[1:])
+                row.append(d if d <= 1. - IOU_THRESHOLD else None)
+                if row[-1] is not None:
+                    overlaps[o[0], h[0]] += 1
+            dists.append(row)
+
+        omask, hmask = [False] * len(objs), [False] * len(hyps)
+        if objs and hyps:
+            for i, o in enumerate(objs):
+                if o[0] not in m or last_match[o[0]] != last_frame:
+                    continue
+                for j, h in enumerate(hyps):
+                    if not hmask[j] and h[0] == m[o[0]]:
+                        if dists[i][j] is not None:
+                            omask[i] = hmask[j] = True
+                            last_match[o[0]] = frame
+                            events.append((frame, 'MATCH', o[0], h[0], dists[i][j]))
+                        break
+
+            free = [[None if omask[i] or hmask[j] else dists[i][j] for j in range(len(hyps))] for i in range(len(objs))]
+            for i, j in assign_feasible(free):
+                o, h = objs[i][0], hyps[j][0]
+                kind = 'SWITCH' if o in m and m[o] != h else 'MATCH'
+                omask[i] = hmask[j] = True
+                m[o] = h
+                last_match[o] = frame
+                events.append((frame, kind, o, h, dists[i][j]))
+
+        events += [(frame, 'MISS', o[0], None, None) for i, o in enumerate(objs) if not omask[i]]
+        events += [(frame, 'FP', None, h[0], None) for j, h in enumerate(hyps) if not hmask[j]]
+        last_frame = frame
+
+    num_objects = sum(len(v) for v in gt.values())
+    num_predictions = sum(len(v) for v in res.values())
+    count = defaultdict(int)
+    for e in events:
+        count[e[1]] += 1
+    detections = count['MATCH'] + count['SWITCH']
+    distance = sum(e[4] for e in events if e[1] in ('MATCH', 'SWITCH'))
+
+    # Fragmentations: tracked -> missed transitions between the first and last tracked frames
+    fragmentations = 0
+    mt = pt = ml = 0
+    for o in sorted({row[0] for rows in gt.values() for row in rows}):
+        kinds = [e[1] for e in events if e[2] == o]
+        tracked = [k != 'MISS' for k in kinds]
+        ratio = sum(tracked) / len(kinds)
+        mt += ratio >= 0.8
+        ml += ratio < 0.2
+        pt += 0.2 <= ratio < 0.8
+        if any(tracked):
+            first = tracked.index(True)
+            last = len(tracked) - 1 - tracked[::-1].index(True)
+            span = tracked[first:last + 1]
+            fragmentations += sum(1 for a, b in zip(span, span[1:]) if a and not b)
+
+    # IDF1: global one-to-one id assignment maximising the overlapping frames
+    oids = sorted({o for o, _ in overlaps})
+    hids = sorted({h for _, h in overlaps})
+    idtp = sum(overlaps[oids[i], hids[j]] for i, j in
+               assign([[-overlaps.get((o, h), 0) for h in hids] for o in oids]))
+
+    return {
+        'mota': 1. - (count['MISS'] + count['SWITCH'] + count['FP']) / num_objects,
+        'motp': distance / detections,
+        'idf1': 2. * idtp / (num_objects + num_predictions),
+        'num_switches': count['SWITCH'],
+        'num_fragmentations': fragmentations,
+        'num_misses': count['MISS'],
+        'num_false_positives': count['FP'],
+        'mostly_tracked': mt,
+        'partially_tracked': pt,
+        'mostly_lost': ml,
+    }
+
+
+def hota_port(gt, res):
+    frames = range(1, max(set(gt) | set(res)) + 1)
+    gt_index = {i: k for k, i in enumerate(sorted({r[0] for rows in gt.values() for r in rows}))}
+    hyp_index = {i: k for k, i in enumerate(sorted({r[0] for rows in res.values() for r in rows}))}
+    ng, nh = len(gt_index), len(hyp_index)
+
+    steps = []
+    for t in frames:
+        g, h = gt.get(t, []), res.get(t, [])
+        sim = [[iou(a[1:], b[1:]) for b in h] for a in g]
+        steps.append(([gt_index[a[0]] for a in g], [hyp_index[b[0]] for b in h], sim))
+
+    eps = 2.220446049250313e-16
+    potential = [[0.] * nh for _ in range(ng)]
+    gt_count, hyp_count = [0] * ng, [0] * nh
+    for gids, hids, sim in steps:
+        rows = [sum(r) for r in sim]
+        cols = [sum(sim[i][j] for i in range(len(gids))) for j in range(len(hids))]
+        for i, gi in enumerate(gids):
+            for j, hj in enumerate(hids):
+                denom = rows[i] + cols[j] - sim[i][j]
+                if denom > 0 + eps:
+                    potential[gi][hj] += sim[i][j] / denom
+        for gi in gids:
+            gt_count[gi] += 1
+        for hj in hids:
+            hyp_count[hj] += 1
+    alignment = [[potential[i][j] / (gt_count[i] + hyp_count[j] - potential[i][j]) for j in range(nh)] for i in range(ng)]
+
+    na = len(ALPHAS)
+    tp, fn, fp, loc = [0] * na, [0] * na, [0] * na, [0.] * na
+    matches = [[[0] * nh for _ in range(ng)] for _ in range(na)]
+    for gids, hids, sim in steps:
+        if not gids:
+            fp = [v + len(hids) for v in fp]
+            continue
+        if not hids:
+            fn = [v + len(gids) for v in fn]
+            continue
+        score = [[-alignment[gi][hj] * sim[i][j] for j, hj in enumerate(hids)] for i, gi in enumerate(gids)]
+        pairs = assign(score)
+        for a, alpha in enumerate(ALPHAS):
+            matched = [(i, j) for i, j in pairs if sim[i][j] >= alpha - eps]
+            tp[a] += len(matched)
+            fn[a] += len(gids) - len(matched)
+            fp[a] += len(hids) - len(matched)
+            for i, j in matched:
+                loc[a] += sim[i][j]
+                matches[a][gids[i]][hids[j]] += 1
+
+    hota, deta, assa = [], [], []
+    for a in range(na):
+        ass = sum(c * c / max(1, gt_count[i] + hyp_count[j] - c)
+                  for i, row in enumerate(matches[a]) for j, c in enumerate(row))
+        assa.append(ass / max(1, tp[a]))
+        deta.append(tp[a] / max(1, tp[a] + fn[a] + fp[a]))
+        hota.append(math.sqrt(deta[a] * assa[a]))
+    mean = lambda values: sum(values) / len(values)
+    return {'hota': mean(hota), 'deta': mean(deta), 'assa': mean(assa)}
+
+
+def clear_mot_packages():
+    import motmetrics as mm
+
+    gt = mm.io.loadtxt(GT, fmt='mot15-2D', min_confidence=1)
+    res = mm.io.loadtxt(RES, fmt='mot15-2D')
+    acc = mm.utils.compare_to_groundtruth(gt, res, 'iou', distth=IOU_THRESHOLD)
+    names = ['mota', 'motp', 'idf1', 'num_switches', 'num_fragmentations', 'num_misses',
+             'num_false_positives', 'mostly_tracked', 'partially_tracked', 'mostly_lost']
+    summary = mm.metrics.create().compute(acc, metrics=names, name='fixture')
+    return {name: float(summary[name].iloc[0]) if name in ('mota', 'motp', 'idf1') else int(summary[name].iloc[0])
+            for name in names}
+
+
+def hota_packages(gt, res):
+    import numpy as np
+    from trackeval.datasets._base_dataset import _BaseDataset
+    from trackeval.metrics import HOTA
+
+    gt_index = {i: k for k, i in enumerate(sorted({r[0] for rows in gt.values() for r in rows}))}
+    hyp_index = {i: k for k, i in enumerate(sorted({r[0] for rows in res.values() for r in rows}))}
+    data = {'num_gt_ids': len(gt_index), 'num_tracker_ids': len(hyp_index),
+            'num_gt_dets': sum(len(v) for v in gt.values()), 'num_tracker_dets': sum(len(v) for v in res.values()),
+            'gt_ids': [], 'tracker_ids': [], 'similarity_scores': []}
+    for t in range(1, max(set(gt) | set(res)) + 1):
+        g, h = gt.get(t, []), res.get(t, [])
+        data['gt_ids'].append(np.array([gt_index[r[0]] for r in g], dtype=int))
+        data['tracker_ids'].append(np.array([hyp_index[r[0]] for r in h], dtype=int))
+        data['similarity_scores'].append(_BaseDataset._calculate_box_ious(
+            np.array([r[1:] for r in g], dtype=float).reshape(-1, 4),
+            np.array([r[1:] for r in h], dtype=float).reshape(-1, 4), box_format='xywh'))
+    result = HOTA().eval_sequence(data)
+    return {name: float(np.mean(result[name])) for name in ('HOTA', 'DetA', 'AssA')}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--port', action='store_true', help='use the Python transcription, not the packages')
+    args = parser.parse_args()
+
+    gt, res = load(GT, 1.), load(RES, float('-inf'))
+    if args.port:
+        metrics = clear_mot_port(gt, res)
+        metrics.update(hota_port(gt, res))
+    else:
+        metrics = clear_mot_packages()
+        metrics.update({k.lower(): v for k, v in hota_packages(gt, res).items()})
+
+    for name, value in metrics.items():
+        print(f'{name} {value:.6f}' if isinstance(value, float) else f'{name} {int(value)}')
+
+
+if __name__ == '__main__':
+    main()
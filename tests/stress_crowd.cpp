@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <metrics/mot_metrics.hpp>
+#include <synthetic/crowd.hpp>
+#include <tracking/sort.hpp>
+#include <tracking/tiled.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+// Load tests on synthetic crowds of constant density, up to 10k objects per frame.
+// Too slow for the unit suite: run with `meson test -C build --benchmark mot_stress`.
+
+namespace
+{
+    struct CrowdRun
+    {
+        double ms_per_frame = 0.;
+        MotMetrics metrics{};
+    };
+
+    // Scoring is quadratic in the objects per frame, so both runs are scored on the same
+    // window, the canvas of a 1k crowd
+    bool inWindow(const Detection &det)
+    {
+        CrowdConfig reference;
+        float area = 1000.f / reference.density;
+        float width = std::sqrt(area * reference.aspect_ratio);
+        float height = area / width;
+        float cx = det.bbox.x + det.bbox.width / 2.f;
+        float cy = det.bbox.y + det.bbox.height / 2.f;
+        return cx < width && cy < height;
+    }
+
+    CrowdRun trackCrowd(size_t num_objects, int frames)
+    {
+        CrowdConfig crowd;
+        crowd.num_objects = num_objects;
+        crowd.seed = 11;
+        crowd.miss_rate = 0.05f;
+        crowd.false_positive_rate = 0.02f;
+
+        TilingConfig tiling;
+        tiling.tile_width = 1920.f;
+        tiling.tile_height = 1080.f;
+        tiling.overlap = 128.f;
+        tiling.num_threads = 1;
+        TiledTracker tracker(tiling, []()
+                             { return std::make_unique<Sort>(SortConfig{}); });
+
+        CrowdGenerator generator(crowd);
+        std::vector<Detection> detections, ground_truth, all_gt, all_tracks;
+        std::chrono::steady_clock::duration elapsed{};
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            generator.next(detections, ground_truth);
+
+            auto start = std::chrono::steady_clock::now();
+            tracker.update(detections);
+            elapsed += std::chrono::steady_clock::now() - start;
+
+            for (const auto &det : ground_truth)
+                if (inWindow(det))
+                    all_gt.push_back(det);
+            for (const auto &det : detections)
+                if (det.track_id > 0 && inWindow(det))
+                    all_tracks.push_back(det);
+        }
+
+        CrowdRun run;
+        run.ms_per_frame = std::chrono::duration<double, std::milli>(elapsed).count() / frames;
+        run.metrics = evaluateMot(all_gt, all_tracks);
+        return run;
+    }
+}
+
+TEST(CrowdStressTest, GeneratorScalesLinearly)
+{
+    // Same number of generated detections at both sizes, so each timing lasts tens of
+    // milliseconds; the fastest of a few repeats filters out scheduling noise
+    auto timeFrames = [](size_t num_objects)
+    {
+        CrowdConfig config;
+        config.num_objects = num_objects;
+        config.feature_dim = 128;
+        CrowdGenerator generator(config);
+        std::vector<Detection> detections;
+        int frames = static_cast<int>(200000 / num_objects);
+
+        double best = std::numeric_limits<double>::max();
+        for (int repeat = 0; repeat < 3; ++repeat)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; ++frame)
+                generator.next(detections);
+            best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / frames);
+        }
+        return best;
+    };
+
+    double exponent = std::log(timeFrames(10000) / timeFrames(1000)) / std::log(10.);
+    RecordProperty("exponent", std::to_string(exponent));
+    EXPECT_LT(exponent, 1.3);
+}
+
+TEST(CrowdStressTest, TiledSortScalesSubQuadratically)
+{
+    auto small = trackCrowd(1000, 40);
+    auto large = trackCrowd(10000, 40);
+
+    double exponent = std::log(large.ms_per_frame / small.ms_per_frame) / std::log(10.);
+    RecordProperty("ms_per_frame_1k", std::to_string(small.ms_per_frame));
+    RecordProperty("ms_per_frame_10k", std::to_string(large.ms_per_frame));
+    RecordProperty("exponent", std::to_string(exponent));
+    EXPECT_LT(exponent, 1.5);
+
+    // Sparse, slow, well detected crowd: tracking quality must hold at scale
+    EXPECT_GT(large.metrics.mota(), 0.8);
+    EXPECT_NEAR(large.metrics.mota(), small.metrics.mota(), 0.05);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <assignment/affinity.hpp>
+#include <assignment/batch.hpp>
+#include <tracking/batch.hpp>
+
+// --- Packed kernels ---
+
+TEST(AffinityTest, IoUMatrixValues)
+{
+    affinity::Boxes a, b;
+    a.push_back(cv::Rect2f(0, 0, 10, 10));
+    b.push_back(cv::Rect2f(0, 0, 10, 10));   // identical
+    b.push_back(cv::Rect2f(5, 0, 10, 10));   // half overlap: 50 / 150
+    b.push_back(cv::Rect2f(100, 100, 5, 5)); // disjoint
+
+    std::vector<float> out(3);
+    affinity::iou(a, 0, 1, b, 0, 3, out.data(), 3);
+    EXPECT_FLOAT_EQ(out[0], 1.f);
+    EXPECT_NEAR(out[1], 1.f / 3.f, 1e-6f);
+    EXPECT_FLOAT_EQ(out[2], 0.f);
+}
+
+TEST(AssignmentBatchTest, MatchesIndividualSolves)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+
+    hungarian::AssignmentBatch batch;
+    std::vector<cv::Mat_<float>> problems;
+    for (int n : {1, 3, 0, 8, 5})
+    {
+        size_t k = batch.add(n);
+        cv::Mat_<float> cost(n, n);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                batch.cost(k)[i * n + j] = cost(i, j) = dist(rng);
+        problems.push_back(cost);
+    }
+    batch.solve();
+
+    for (size_t k = 0; k < problems.size(); ++k)
+    {
+        auto expected = hungarian::max_cost_assignment(problems[k]);
+        ASSERT_EQ(static_cast<int>(expected.size()), batch.dim(k));
+        for (size_t i = 0; i < expected.size(); ++i)
+            EXPECT_EQ(batch.assignment(k)[i], expected[i]);
+    }
+}
+
+// --- Batched SORT ---
+
+class SortBatchTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        BaseTrack::count = 0;
+        config.max_time_lost = 3;
+        config.match_thresh = 0.3f;
+    }
+
+    SortConfig config;
+
+    // Stream s has s + 1 boxes moving right, objects of the last stream vanish after frame 5
+    static std::vector<Detection> makeFrame(size_t stream, int frame)
+    {
+        std::vector<Detection> dets;
+        size_t count = (stream == 2 && frame > 5) ? 0 : stream + 1;
+        for (size_t k = 0; k < count; ++k)
+        {
+            Detection det;
+            det.bbox = cv::Rect2f(10.f + 3.f * frame + 200.f * k, 50.f, 40.f, 90.f);
+            det.confidence = 0.9f;
+            dets.push_back(det);
+        }
+        return dets;
+    }
+};
+
+TEST_F(SortBatchTest, MatchesIndependentTrackers)
+{
+    const size_t num_streams = 3;
+    SortBatch batched(config, num_streams);
+    std::vector<std::unique_ptr<Sort>> reference;
+    for (size_t s = 0; s < num_streams; ++s)
+        reference.push_back(std::make_unique<Sort>(config));
+
+    // Ids come from a shared counter, so compare the order in which ids first appear
+    std::vector<std::map<int, int>> batched_ids(num_streams), reference_ids(num_streams);
+    auto canonical = [](std::map<int, int> &ids, int id)
+    {
+        if (id <= 0)
+            return id;
+        return ids.emplace(id, static_cast<int>(ids.size())).first->second;
+    };
+
+    for (int frame = 1; frame <= 10; ++frame)
+    {
+        std::vector<std::vector<Detection>> frames;
+        for (size_t s = 0; s < num_streams; ++s)
+            frames.push_back(makeFrame(s, frame));
+        batched.update(frames);
+
+        for (size_t s = 0; s < num_streams; ++s)
+        {
+            auto dets = makeFrame(s, frame);
+            reference[s]->update(dets);
+
+            ASSERT_EQ(dets.size(), frames[s].size());
+            for (size_t i = 0; i < dets.size(); ++i)
+                EXPECT_EQ(canonical(batched_ids[s], frames[s][i].track_id), canonical(reference_ids[s], dets[i].track_id));
+            EXPECT_EQ(batched.getTracker(s).getTracks().size(), reference[s]->getTracks().size());
+        }
+    }
+}
+
+TEST_F(SortBatchTest, WrongStreamCountThrows)
+{
+    SortBatch batched(config, 2);
+    std::vector<std::vector<Detection>> frames(3);
+    EXPECT_THROW(batched.update(frames), std::invalid_argument);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <io/binary_detections.hpp>
+#include <io/detection_file.hpp>
+
+#include <cstddef>
+#include <fstream>
+#include <limits>
+
+class BinaryDetectionsTest : public testing::Test
+{
+protected:
+    std::filesystem::path path;
+
+    void SetUp() override
+    {
+        path = std::filesystem::path(testing::TempDir()) /
+               (std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + ".motb");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    static Detection makeDet(int frame_id, float x, float y, float w, float h, std::vector<float> features = {})
+    {
+        Detection det;
+        det.frame_id = frame_id;
+        det.track_id = -1;
+        det.class_id = 1;
+        det.bbox = cv::Rect2f(x, y, w, h);
+        det.confidence = 0.9f;
+        det.features = std::move(features);
+        return det;
+    }
+};
+
+TEST_F(BinaryDetectionsTest, RoundTrip)
+{
+    std::vector<Detection> detections = {
+        makeDet(2, 10, 20, 30, 40),
+        makeDet(2, 50, 60, 70, 80),
+        makeDet(4, 1.5f, 2.5f, 3.5f, 4.5f),
+    };
+    writeBinaryDetections(path, detections);
+
+    BinaryDetectionFile file(path);
+    EXPECT_EQ(file.size(), 3u);
+    EXPECT_EQ(file.getFirstFrame(), 2);
+    EXPECT_EQ(file.getLastFrame(), 4);
+    EXPECT_EQ(file.getFeatureDim(), 0u);
+
+    std::vector<Detection> frame;
+    file.readFrame(2, frame);
+    ASSERT_EQ(frame.size(), 2u);
+    EXPECT_EQ(frame[0].frame_id, 2);
+    EXPECT_EQ(frame[0].track_id, -1);
+    EXPECT_EQ(frame[0].class_id, 1);
+    EXPECT_FLOAT_EQ(frame[1].bbox.x, 50.f);
+    EXPECT_FLOAT_EQ(frame[1].bbox.height, 80.f);
+    EXPECT_FLOAT_EQ(frame[1].confidence, 0.9f);
+
+    file.readFrame(3, frame);
+    EXPECT_TRUE(frame.empty());
+
+    file.readFrame(4, frame);
+    ASSERT_EQ(frame.size(), 1u);
+    EXPECT_FLOAT_EQ(frame[0].bbox.width, 3.5f);
+
+    file.readFrame(5, frame);
+    EXPECT_TRUE(frame.empty());
+}
+
+TEST_F(BinaryDetectionsTest, ColumnsAreAligned)
+{
+    std::vector<Detection> detections = {makeDet(1, 0, 0, 1, 1, {1.f, 2.f, 3.f}), makeDet(1, 0, 0, 2, 2, {4.f, 5.f, 6.f})};
+    writeBinaryDetections(path, detections);
+
+    BinaryDetectionFile file(path);
+    auto frame = file.getFrame(1);
+    ASSERT_EQ(frame.size(), 2u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(frame.x.data()) % BINARY_ALIGNMENT, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(frame.confidence.data()) % BINARY_ALIGNMENT, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(frame.features.data()) % BINARY_ALIGNMENT, 0u);
+
+    ASSERT_EQ(frame.feature_dim, 3u);
+    ASSERT_EQ(frame.features.size(), 6u);
+    EXPECT_FLOAT_EQ(frame.features[4], 5.f);
+
+    std::vector<Detection> dets;
+    file.readFrame(1, dets);
+    EXPECT_EQ(dets[1].features, (std::vector<float>{4.f, 5.f, 6.f}));
+}
+
+TEST_F(BinaryDetectionsTest, ExternalFeatures)
+{
+    std::vector<Detection> detections = {makeDet(1, 0, 0, 1, 1), makeDet(2, 0, 0, 2, 2)};
+    std::vector<float> features = {1.f, 2.f, 3.f, 4.f};
+    writeBinaryDetections(path, detections, features, 2);
+
+    BinaryDetectionFile file(path);
+    EXPECT_EQ(file.getFeatureDim(), 2u);
+
+    std::vector<Detection> frame;
+    file.readFrame(2, frame);
+    ASSERT_EQ(frame.size(), 1u);
+    EXPECT_EQ(frame[0].features, (std::vector<float>{3.f, 4.f}));
+
+    EXPECT_THROW(writeBinaryDetections(path, detections, features, 3), std::invalid_argument);
+}
+
+TEST_F(BinaryDetectionsTest, MatchesTextFile)
+{
+    auto text_path = path;
+    text_path.replace_extension(".txt");
+    {
+        std::ofstream text(text_path);
+        text << "3,-1,5,6,7,8,0.5,-1,-1,-1\n"
+             << "1,-1,1,2,3,4,0.25,-1,-1,-1\n"
+             << "1,-1,9,9,9,9,0.75,-1,-1,-1\n";
+    }
+
+    DetectionFile text_file(text_path);
+    writeBinaryDetections(path, text_file.getDetections());
+    BinaryDetectionFile binary_file(path);
+
+    std::vector<Detection> frame;
+    for (int frame_id = 1; frame_id <= 3; ++frame_id)
+    {
+        auto expected = text_file.getFrame(frame_id);
+        binary_file.readFrame(frame_id, frame);
+        ASSERT_EQ(frame.size(), expected.size());
+        for (size_t i = 0; i < frame.size(); ++i)
+        {
+            EXPECT_EQ(frame[i].bbox, expected[i].bbox);
+            EXPECT_FLOAT_EQ(frame[i].confidence, expected[i].confidence);
+        }
+    }
+
+    std::filesystem::remove(text_path);
+}
+
+TEST_F(BinaryDetectionsTest, EmptySequence)
+{
+    writeBinaryDetections(path, {});
+
+    BinaryDetectionFile file(path);
+    EXPECT_TRUE(file.empty());
+    EXPECT_EQ(file.getFrame(0).size(), 0u);
+}
+
+TEST_F(BinaryDetectionsTest, RejectsInvalidInput)
+{
+    std::vector<Detection> unsorted = {makeDet(2, 0, 0, 1, 1), makeDet(1, 0, 0, 1, 1)};
+    EXPECT_THROW(writeBinaryDetections(path, unsorted), std::invalid_argument);
+
+    std::vector<Detection> ragged = {makeDet(1, 0, 0, 1, 1, {1.f}), makeDet(1, 0, 0, 1, 1)};
+    EXPECT_THROW(writeBinaryDetections(path, ragged), std::invalid_argument);
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not a binary detection file at all";
+    }
+    EXPECT_THROW(BinaryDetectionFile file(path), std::runtime_error);
+}
+
+TEST_F(BinaryDetectionsTest, RejectsCorruptHeaderAndIndex)
+{
+    std::vector<Detection> detections = {makeDet(1, 0, 0, 1, 1), makeDet(2, 0, 0, 1, 1), makeDet(3, 0, 0, 1, 1)};
+    auto patch = [&](std::streamoff offset, const auto &value)
+    {
+        writeBinaryDetections(path, detections);
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offset);
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    constexpr std::streamoff last_frame = offsetof(BinaryHeader, last_frame);
+    constexpr std::streamoff num_rows = offsetof(BinaryHeader, num_rows);
+    constexpr std::streamoff index = BINARY_ALIGNMENT;
+
+    // Frame range far larger than the file, would wrap the layout arithmetic
+    patch(last_frame, std::numeric_limits<int32_t>::max());
+    EXPECT_THROW(BinaryDetectionFile file(path), std::runtime_error);
+
+    patch(num_rows, std::numeric_limits<uint64_t>::max() / 2);
+    EXPECT_THROW(BinaryDetectionFile file(path), std::runtime_error);
+
+    // Spans past the columns, decreasing, or not covering every row
+    patch(index + 2 * sizeof(uint64_t), uint64_t{1000});
+    EXPECT_THROW(BinaryDetectionFile file(path), std::runtime_error);
+
+    patch(index + sizeof(uint64_t), uint64_t{3});
+    EXPECT_THROW(BinaryDetectionFile file(path), std::runtime_error);
+
+    patch(index, uint64_t{1});
+    EXPECT_THROW(BinaryDetectionFile file(path), std::runtime_error);
+
+    patch(index + 3 * sizeof(uint64_t), uint64_t{2});
+    EXPECT_THROW(BinaryDetectionFile file(path), std::runtime_error);
+}
@@ -90,6 +90,22 @@ TEST_F(BotSortTrackTest, UpdateResetsTimeSinceUpdate)
     EXPECT_EQ(track.time_since_update, 0u);
 }
 
+TEST_F(BotSortTrackTest, MemoryCountsFilterHistoryAndFeatures)
+{
+    BotSortTrack track(rect, std::vector<float>(128, 0.1f), config);
+    MemoryReport report;
+    track.addMemory(report);
+
+    EXPECT_EQ(report.num_tracks, 1u);
+    EXPECT_EQ(report.tracks, sizeof(BotSortTrack));
+    EXPECT_EQ(report.history, MAX_HISTORY * sizeof(cv::Rect2f));
+    EXPECT_EQ(report.features, 128 * sizeof(float));
+    // 8x8 covariances and transition, 8x1 states, at least
+    EXPECT_GT(report.filters, SHARED_CONTROL_BLOCK + 4 * 64 * sizeof(float));
+    EXPECT_EQ(report.scratch, 0u);
+    EXPECT_EQ(report.total(), report.tracks + report.filters + report.history + report.features);
+}
+
 // --- BotSort tracker integration tests ---
 
 class BotSortTest : public testing::Test
@@ -227,3 +243,82 @@ TEST_F(BotSortTest, MultipleHighConfDetectionsCreateMultipleTracks)
     tracker.update(dets);
     EXPECT_EQ(tracker.getTracks().size(), 2u);
 }
+
+TEST_F(BotSortTest, ClassAwareDoesNotMatchAcrossClasses)
+{
+    config.class_aware = true;
+    BotSort tracker(config);
+    std::vector<Detection> dets = {makeDet(10, 20, 100, 50, 0.9f)};
+    dets[0].class_id = 1;
+    tracker.update(dets);   // New
+    tracker.update(dets);   // Active
+    int track_id = dets[0].track_id;
+    EXPECT_GT(track_id, 0);
+
+    std::vector<Detection> other = {makeDet(10, 20, 100, 50, 0.9f)};
+    other[0].class_id = 2;
+    tracker.update(other);
+
+    // The class 1 track is lost and a new class 2 track is started
+    EXPECT_NE(other[0].track_id, track_id);
+    ASSERT_EQ(tracker.getTracks().size(), 2u);
+    EXPECT_TRUE(tracker.getTracks()[0]->isLost());
+    EXPECT_EQ(tracker.getTracks()[1]->class_id, 2);
+}
+
+TEST_F(BotSortTest, MultiThreadedUpdateIsDeterministic)
+{
+    auto makeFrame = [](int frame)
+    {
+        std::vector<Detection> dets;
+        for (int k = 0; k < 300; ++k)
+        {
+            if ((k + frame) % 7 == 0)
+                continue;
+            float jitter = static_cast<float>((k * 31 + frame * 17) % 5);
+            float conf = (k % 5 == 0) ? 0.3f : 0.9f;
+            dets.push_back(makeDet(50.f * (k % 25) + frame + jitter, 50.f * (k / 25) + jitter, 30, 40, conf));
+        }
+        return dets;
+    };
+
+    auto run = [&](size_t num_threads)
+    {
+        BaseTrack::count = 0;
+        config.num_threads = num_threads;
+        BotSort tracker(config);
+        std::vector<int> ids;
+        for (int frame = 0; frame < 6; ++frame)
+        {
+            auto dets = makeFrame(frame);
+            tracker.update(dets);
+            for (const auto &det : dets)
+                ids.push_back(det.track_id);
+            for (const auto &track : tracker.getTracks())
+                ids.push_back(track->id);
+        }
+        return ids;
+    };
+
+    EXPECT_EQ(run(1), run(4));
+}
+
+TEST_F(BotSortTest, MemoryReportFollowsTracks)
+{
+    BotSort tracker(config);
+    EXPECT_EQ(tracker.getMemoryReport().num_tracks, 0u);
+
+    std::vector<Detection> dets = {makeDet(10.f, 10.f, 50.f, 100.f), makeDet(300.f, 300.f, 50.f, 100.f)};
+    for (auto &det : dets)
+        det.features = std::vector<float>(64, 0.125f);
+    tracker.update(dets);
+
+    auto report = tracker.getMemoryReport();
+    EXPECT_EQ(report.num_tracks, 2u);
+    EXPECT_GE(report.features, 2 * 64 * sizeof(float));
+    EXPECT_GE(report.tracks, 2 * sizeof(BotSortTrack));
+
+    MemoryReport single;
+    tracker.getTracks().front()->addMemory(single);
+    EXPECT_LT(single.total(), report.total());
+}
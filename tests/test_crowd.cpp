@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <synthetic/crowd.hpp>
+#include <io/detection_file.hpp>
+#include <io/npy.hpp>
+#include <io/sequence.hpp>
+
+#include <cmath>
+#include <numeric>
+
+static float cosine(const std::vector<float> &a, const std::vector<float> &b)
+{
+    return std::inner_product(a.begin(), a.end(), b.begin(), 0.f);
+}
+
+TEST(CrowdTest, SameSeedSameStream)
+{
+    CrowdConfig config;
+    config.seed = 3;
+    config.motion = MotionModel::RandomWalk;
+    config.miss_rate = 0.1f;
+    config.false_positive_rate = 0.05f;
+    config.feature_dim = 8;
+
+    CrowdGenerator a(config), b(config);
+    std::vector<Detection> da, db;
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        a.next(da);
+        b.next(db);
+        ASSERT_EQ(da.size(), db.size());
+        for (size_t i = 0; i < da.size(); ++i)
+        {
+            EXPECT_EQ(da[i].bbox, db[i].bbox);
+            EXPECT_EQ(da[i].features, db[i].features);
+        }
+    }
+
+    CrowdGenerator same(config);
+    config.seed = 4;
+    CrowdGenerator other(config);
+    same.next(da);
+    other.next(db);
+    EXPECT_NE(da.front().bbox, db.front().bbox);
+}
+
+TEST(CrowdTest, CanvasFollowsDensity)
+{
+    CrowdConfig config;
+    config.num_objects = 1000;
+    config.density = 1e-4f;
+
+    CrowdGenerator generator(config);
+    EXPECT_NEAR(generator.getWidth() * generator.getHeight(), 1e7f, 1e3f);
+    EXPECT_NEAR(generator.getWidth() / generator.getHeight(), 16.f / 9.f, 1e-3f);
+}
+
+TEST(CrowdTest, ObjectsStayOnCanvas)
+{
+    CrowdConfig config;
+    config.num_objects = 200;
+    config.speed = 20.f;
+    config.motion = MotionModel::RandomWalk;
+
+    CrowdGenerator generator(config);
+    std::vector<Detection> detections;
+    for (int frame = 0; frame < 200; ++frame)
+    {
+        generator.next(detections);
+        for (const auto &box : generator.getBoxes())
+        {
+            ASSERT_GE(box.x, 0.f);
+            ASSERT_GE(box.y, 0.f);
+            ASSERT_LE(box.x + box.width, generator.getWidth() + 1e-3f);
+            ASSERT_LE(box.y + box.height, generator.getHeight() + 1e-3f);
+        }
+    }
+}
+
+TEST(CrowdTest, GroundTruthHasEveryObject)
+{
+    CrowdConfig config;
+    config.num_objects = 50;
+    config.occlusion_rate = 0.5f;
+
+    CrowdGenerator generator(config);
+    std::vector<Detection> detections, ground_truth;
+    generator.next(detections, ground_truth);
+
+    ASSERT_EQ(ground_truth.size(), 50u);
+    EXPECT_EQ(ground_truth.front().track_id, 1);
+    EXPECT_EQ(ground_truth.back().track_id, 50);
+    EXPECT_EQ(ground_truth.front().frame_id, 1);
+    EXPECT_LT(detections.size(), 50u);
+}
+
+TEST(CrowdTest, RatesMatchConfig)
+{
+    CrowdConfig config;
+    config.num_objects = 1000;
+    config.miss_rate = 0.2f;
+    config.occlusion_rate = 0.25f;
+    config.occlusion_length = 5.f;
+    config.false_positive_rate = 0.1f;
+
+    CrowdGenerator generator(config);
+    std::vector<Detection> detections;
+    const int frames = 200;
+    size_t detected = 0, visible = 0;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        generator.next(detections);
+        for (size_t i = 0; i < config.num_objects; ++i)
+            visible += generator.isVisible(i);
+
+        // False positives come last, exactly rate x objects per frame
+        ASSERT_GE(detections.size(), 100u);
+        detected += detections.size() - 100;
+    }
+
+    double total = static_cast<double>(frames * config.num_objects);
+    EXPECT_NEAR(visible / total, 0.75, 0.02);
+    EXPECT_NEAR(detected / static_cast<double>(visible), 0.8, 0.02);
+}
+
+TEST(CrowdTest, IdentitySeparation)
+{
+    CrowdConfig config;
+    config.num_objects = 20;
+    config.feature_dim = 128;
+    config.feature_noise = 0.2f;
+
+    CrowdGenerator separated(config);
+    std::vector<Detection> first, second;
+    separated.next(first);
+    separated.next(second);
+
+    // Same identity across frames is close, different identities are not
+    EXPECT_GT(cosine(first[0].features, second[0].features), 0.9f);
+    EXPECT_LT(std::abs(cosine(first[0].features, second[1].features)), 0.5f);
+    EXPECT_NEAR(cosine(first[0].features, first[0].features), 1.f, 1e-5f);
+
+    config.identity_separation = 0.f;
+    config.feature_noise = 0.f;
+    CrowdGenerator identical(config);
+    identical.next(first);
+    EXPECT_NEAR(cosine(first[0].features, first[1].features), 1.f, 1e-5f);
+}
+
+TEST(CrowdTest, WritesSequence)
+{
+    auto path = std::filesystem::path(testing::TempDir()) / "CrowdTest-WritesSequence";
+    CrowdConfig config;
+    config.num_objects = 30;
+    config.feature_dim = 4;
+    config.miss_rate = 0.1f;
+    writeCrowdSequence(config, path, 10);
+
+    auto info = parseSequenceInfo(path / "seqinfo.ini");
+    EXPECT_EQ(info.seqLength, 10);
+    EXPECT_GT(info.imWidth, 0);
+
+    DetectionFile gt(path / "gt/gt.txt");
+    EXPECT_EQ(gt.size(), 300u);
+    EXPECT_EQ(gt.getLastFrame(), 10);
+
+    DetectionFile det(path / "det/det.txt");
+    NpyArray features(path / "det/det.npy");
+    EXPECT_EQ(features.rows(), det.size());
+    EXPECT_EQ(features.cols(), 4u);
+
+    std::filesystem::remove_all(path);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <io/detection_file.hpp>
+
+#include <fstream>
+
+class DetectionFileTest : public testing::Test
+{
+protected:
+    std::filesystem::path path;
+
+    void SetUp() override
+    {
+        path = std::filesystem::path(testing::TempDir()) /
+               (std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + ".txt");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    void write(const std::string &content) const
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+};
+
+TEST_F(DetectionFileTest, ParsesSortedFile)
+{
+    write("1,-1,10,20,30,40,0.9,-1,-1,-1\n"
+          "1,-1,50,60,70,80,0.5,-1,-1,-1\n"
+          "2,-1,11.5,21.5,30,40,0.8,-1,-1,-1\n");
+
+    DetectionFile file(path);
+    EXPECT_EQ(file.size(), 3u);
+    EXPECT_EQ(file.getFirstFrame(), 1);
+    EXPECT_EQ(file.getLastFrame(), 2);
+
+    auto frame = file.getFrame(1);
+    ASSERT_EQ(frame.size(), 2u);
+    EXPECT_EQ(frame[0].frame_id, 1);
+    EXPECT_EQ(frame[0].track_id, -1);
+    EXPECT_FLOAT_EQ(frame[0].bbox.x, 10.f);
+    EXPECT_FLOAT_EQ(frame[0].bbox.height, 40.f);
+    EXPECT_FLOAT_EQ(frame[0].confidence, 0.9f);
+    EXPECT_FLOAT_EQ(frame[1].bbox.x, 50.f);
+
+    frame = file.getFrame(2);
+    ASSERT_EQ(frame.size(), 1u);
+    EXPECT_FLOAT_EQ(frame[0].bbox.y, 21.5f);
+}
+
+TEST_F(DetectionFileTest, GroupsUnsortedFileStably)
+{
+    write("3,1,0,0,1,1,1\n"
+          "1,2,0,0,1,1,1\n"
+          "3,3,0,0,1,1,1\n"
+          "1,4,0,0,1,1,1\n");
+
+    DetectionFile file(path);
+    EXPECT_EQ(file.getFirstFrame(), 1);
+    EXPECT_EQ(file.getLastFrame(), 3);
+
+    auto first = file.getFrame(1);
+    ASSERT_EQ(first.size(), 2u);
+    EXPECT_EQ(first[0].track_id, 2);
+    EXPECT_EQ(first[1].track_id, 4);
+
+    EXPECT_TRUE(file.getFrame(2).empty());
+
+    auto last = file.getFrame(3);
+    ASSERT_EQ(last.size(), 2u);
+    EXPECT_EQ(last[0].track_id, 1);
+    EXPECT_EQ(last[1].track_id, 3);
+
+    // Original line order, for row-aligned sidecar files
+    auto first_rows = file.getFrameRows(1);
+    ASSERT_EQ(first_rows.size(), 2u);
+    EXPECT_EQ(first_rows[0], 1u);
+    EXPECT_EQ(first_rows[1], 3u);
+    auto last_rows = file.getFrameRows(3);
+    ASSERT_EQ(last_rows.size(), 2u);
+    EXPECT_EQ(last_rows[0], 0u);
+    EXPECT_EQ(last_rows[1], 2u);
+    EXPECT_TRUE(file.getFrameRows(2).empty());
+}
+
+TEST_F(DetectionFileTest, ToleratesWhitespaceAndBlankLines)
+{
+    write("1, 7, 1.0, 2.0, 3.0, 4.0, 1, 2, 0.5\r\n"
+          "\r\n"
+          "2, 8, 1.0, 2.0, 3.0, 4.0, 0, 1, 0.25");
+
+    DetectionFile file(path);
+    ASSERT_EQ(file.size(), 2u);
+    EXPECT_EQ(file.getFrame(1)[0].track_id, 7);
+    EXPECT_EQ(file.getFrame(1)[0].class_id, 2);
+    EXPECT_EQ(file.getFrame(2)[0].class_id, 1);
+    EXPECT_FLOAT_EQ(file.getFrame(2)[0].bbox.width, 3.f);
+}
+
+TEST_F(DetectionFileTest, OutOfRangeFramesAreEmpty)
+{
+    write("5,-1,0,0,1,1,1\n");
+
+    DetectionFile file(path);
+    EXPECT_TRUE(file.getFrame(0).empty());
+    EXPECT_TRUE(file.getFrame(4).empty());
+    EXPECT_EQ(file.getFrame(5).size(), 1u);
+    EXPECT_TRUE(file.getFrame(6).empty());
+}
+
+TEST_F(DetectionFileTest, EmptyFile)
+{
+    write("");
+
+    DetectionFile file(path);
+    EXPECT_TRUE(file.empty());
+    EXPECT_TRUE(file.getFrame(1).empty());
+}
+
+TEST_F(DetectionFileTest, MalformedLineThrows)
+{
+    write("1,-1,10,20,30\n");
+    EXPECT_THROW(DetectionFile file(path), std::runtime_error);
+}
+
+TEST_F(DetectionFileTest, OutOfRangeFrameIdThrows)
+{
+    write("1,-1,10,20,30,40,0.9\n-3,-1,10,20,30,40,0.9\n");
+    EXPECT_THROW(DetectionFile file(path), std::runtime_error);
+
+    write("1,-1,10,20,30,40,0.9\n2000000000,-1,10,20,30,40,0.9\n");
+    EXPECT_THROW(DetectionFile file(path), std::runtime_error);
+
+    write("0,-1,10,20,30,40,0.9\n");
+    EXPECT_THROW(DetectionFile file(path), std::runtime_error);
+}
+
+TEST_F(DetectionFileTest, MissingFileThrows)
+{
+    EXPECT_THROW(DetectionFile file(path / "missing"), std::system_error);
+}
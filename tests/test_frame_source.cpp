@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <io/frame_source.hpp>
+
+#include <atomic>
+#include <chrono>
+
+namespace
+{
+    // Frame i is a 1x1 image holding i
+    class CountingSource : public FrameSource
+    {
+    public:
+        CountingSource(size_t t_count, bool t_random_access) : count(t_count), random_access(t_random_access) {}
+
+        bool read(cv::Mat &image) override { return readAt(next++, image); }
+        int getFrameCount() const override { return static_cast<int>(count); }
+        double getFrameRate() const override { return 25.; }
+        cv::Size getFrameSize() const override { return {1, 1}; }
+
+        bool isRandomAccess() const override { return random_access; }
+        bool readAt(size_t index, cv::Mat &image) const override
+        {
+            if (index >= count)
+                return false;
+            image.create(1, 1, CV_32F);
+            image.at<float>(0, 0) = static_cast<float>(index);
+            decoded++;
+            return true;
+        }
+
+        mutable std::atomic<size_t> decoded{0};
+
+    private:
+        size_t count;
+        bool random_access;
+        size_t next = 0;
+    };
+}
+
+TEST(FrameSourceTest, NullSourceHasNoFrames)
+{
+    NullSource source;
+    cv::Mat image;
+    EXPECT_FALSE(source.read(image));
+    EXPECT_EQ(source.getFrameCount(), 0);
+}
+
+TEST(FrameSourceTest, ThreadedSequentialSourceKeepsOrder)
+{
+    ThreadedFrameSource source(std::make_unique<CountingSource>(100, false), 4, 4);
+    EXPECT_EQ(source.getFrameCount(), 100);
+    EXPECT_DOUBLE_EQ(source.getFrameRate(), 25.);
+
+    cv::Mat image;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(source.read(image));
+        EXPECT_FLOAT_EQ(image.at<float>(0, 0), static_cast<float>(i));
+    }
+    EXPECT_FALSE(source.read(image));
+    EXPECT_FALSE(source.read(image));
+}
+
+TEST(FrameSourceTest, ThreadedRandomAccessSourceKeepsOrder)
+{
+    ThreadedFrameSource source(std::make_unique<CountingSource>(257, true), 8, 4);
+
+    cv::Mat image;
+    for (size_t i = 0; i < 257; ++i)
+    {
+        ASSERT_TRUE(source.read(image));
+        EXPECT_FLOAT_EQ(image.at<float>(0, 0), static_cast<float>(i));
+    }
+    EXPECT_FALSE(source.read(image));
+}
+
+TEST(FrameSourceTest, PrefetchIsBounded)
+{
+    auto counting = std::make_unique<CountingSource>(100, true);
+    auto *raw = counting.get();
+    ThreadedFrameSource source(std::move(counting), 4, 2);
+
+    // Workers fill the pool and stop
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (raw->decoded < 4 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(raw->decoded, 4u);
+
+    cv::Mat image;
+    ASSERT_TRUE(source.read(image));
+    EXPECT_FLOAT_EQ(image.at<float>(0, 0), 0.f);
+}
+
+TEST(FrameSourceTest, EmptySource)
+{
+    ThreadedFrameSource source(std::make_unique<CountingSource>(0, true), 4, 2);
+    cv::Mat image;
+    EXPECT_FALSE(source.read(image));
+}
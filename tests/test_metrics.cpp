@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include <io/detection_file.hpp>
+#include <metrics/mot_metrics.hpp>
+#include <parallel/thread_pool.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+static Detection box(int frame, int id, float x, float y = 0.f, float confidence = 1.f)
+{
+    Detection det;
+    det.frame_id = frame;
+    det.track_id = id;
+    det.confidence = confidence;
+    det.bbox = cv::Rect2f(x, y, 10.f, 10.f);
+    return det;
+}
+
+TEST(MetricsTest, PerfectTracking)
+{
+    std::vector<Detection> gt;
+    for (int frame = 1; frame <= 10; ++frame)
+    {
+        gt.push_back(box(frame, 1, 0.f));
+        gt.push_back(box(frame, 2, 100.f));
+    }
+
+    auto metrics = evaluateMot(gt, gt);
+    EXPECT_EQ(metrics.frames, 10);
+    EXPECT_EQ(metrics.gt_tracks, 2);
+    EXPECT_EQ(metrics.matches, 20u);
+    EXPECT_EQ(metrics.mostly_tracked, 2);
+    EXPECT_DOUBLE_EQ(metrics.mota(), 1.);
+    EXPECT_NEAR(metrics.motp(), 0., 1e-6);
+    EXPECT_DOUBLE_EQ(metrics.idf1(), 1.);
+    EXPECT_NEAR(metrics.hota(), 1., 1e-6);
+    EXPECT_NEAR(metrics.loca(), 1., 1e-6);
+}
+
+TEST(MetricsTest, NoTracksAreAllMisses)
+{
+    std::vector<Detection> gt{box(1, 1, 0.f), box(2, 1, 0.f)};
+
+    auto metrics = evaluateMot(gt, {});
+    EXPECT_EQ(metrics.misses, 2u);
+    EXPECT_EQ(metrics.mostly_lost, 1);
+    EXPECT_DOUBLE_EQ(metrics.mota(), 0.);
+    EXPECT_DOUBLE_EQ(metrics.recall(), 0.);
+    EXPECT_DOUBLE_EQ(metrics.hota(), 0.);
+}
+
+TEST(MetricsTest, IdentitySwitch)
+{
+    std::vector<Detection> gt, hyp;
+    for (int frame = 1; frame <= 4; ++frame)
+    {
+        gt.push_back(box(frame, 1, 0.f));
+        hyp.push_back(box(frame, frame <= 2 ? 10 : 20, 0.f));
+    }
+
+    auto metrics = evaluateMot(gt, hyp);
+    EXPECT_EQ(metrics.switches, 1u);
+    EXPECT_EQ(metrics.fragmentations, 0u);
+    EXPECT_DOUBLE_EQ(metrics.mota(), 0.75);
+    EXPECT_EQ(metrics.idtp, 2u);
+    EXPECT_DOUBLE_EQ(metrics.idf1(), 0.5);
+
+    // Detection is perfect, each id pair covers half of the track
+    EXPECT_NEAR(metrics.deta(), 1., 1e-6);
+    EXPECT_NEAR(metrics.assa(), 0.5, 1e-6);
+    EXPECT_NEAR(metrics.hota(), std::sqrt(0.5), 1e-6);
+}
+
+TEST(MetricsTest, GapCountsAsFragmentation)
+{
+    std::vector<Detection> gt, hyp;
+    for (int frame = 1; frame <= 5; ++frame)
+    {
+        gt.push_back(box(frame, 1, 0.f));
+        if (frame != 3)
+            hyp.push_back(box(frame, 7, 0.f));
+    }
+
+    auto metrics = evaluateMot(gt, hyp);
+    EXPECT_EQ(metrics.misses, 1u);
+    EXPECT_EQ(metrics.fragmentations, 1u);
+    EXPECT_EQ(metrics.switches, 0u);
+    EXPECT_EQ(metrics.mostly_tracked, 1); // 4 of 5 frames
+}
+
+TEST(MetricsTest, KeepsPreviousCorrespondence)
+{
+    // Hypothesis 2 overlaps better on frame 2, but 1 still matches above the threshold
+    std::vector<Detection> gt{box(1, 1, 0.f), box(2, 1, 0.f)};
+    std::vector<Detection> hyp{box(1, 1, 0.f), box(2, 1, 2.f), box(2, 2, 0.5f)};
+
+    auto metrics = evaluateMot(gt, hyp);
+    EXPECT_EQ(metrics.switches, 0u);
+    EXPECT_EQ(metrics.matches, 2u);
+    EXPECT_EQ(metrics.false_positives, 1u);
+}
+
+TEST(MetricsTest, LowOverlapIsMissAndFalsePositive)
+{
+    std::vector<Detection> gt{box(1, 1, 0.f)};
+    std::vector<Detection> hyp{box(1, 1, 5.f)}; // IoU 1/3
+
+    auto metrics = evaluateMot(gt, hyp);
+    EXPECT_EQ(metrics.matches, 0u);
+    EXPECT_EQ(metrics.misses, 1u);
+    EXPECT_EQ(metrics.false_positives, 1u);
+    EXPECT_DOUBLE_EQ(metrics.mota(), -1.);
+    EXPECT_EQ(metrics.idtp, 0u);
+
+    // HOTA still matches it below IoU 1/3
+    EXPECT_GT(metrics.hota(), 0.);
+}
+
+TEST(MetricsTest, MaximisesMatchesBeforeDistance)
+{
+    // gt 1 is closest to hypothesis 10, but taking it would leave gt 2 unmatched
+    std::vector<Detection> gt{box(1, 1, 0.f), box(1, 2, 3.f)};
+    std::vector<Detection> hyp{box(1, 10, 0.5f), box(1, 20, -3.f)};
+
+    auto metrics = evaluateMot(gt, hyp);
+    EXPECT_EQ(metrics.matches, 2u);
+    EXPECT_EQ(metrics.misses, 0u);
+    EXPECT_EQ(metrics.false_positives, 0u);
+}
+
+TEST(MetricsTest, IgnoresGroundTruthBelowConfidence)
+{
+    std::vector<Detection> gt{box(1, 1, 0.f), box(1, 2, 100.f, 0.f, 0.f)};
+    std::vector<Detection> hyp{box(1, 1, 0.f)};
+
+    auto metrics = evaluateMot(gt, hyp);
+    EXPECT_EQ(metrics.gt_detections, 1u);
+    EXPECT_EQ(metrics.gt_tracks, 1);
+    EXPECT_DOUBLE_EQ(metrics.mota(), 1.);
+}
+
+TEST(MetricsTest, UnsortedRowsMatchSorted)
+{
+    std::vector<Detection> gt, hyp;
+    for (int frame = 1; frame <= 6; ++frame)
+    {
+        gt.push_back(box(frame, 1, static_cast<float>(frame)));
+        gt.push_back(box(frame, 2, 50.f));
+        hyp.push_back(box(frame, 3, static_cast<float>(frame) + 1.f));
+        hyp.push_back(box(frame, frame < 4 ? 4 : 5, 52.f));
+    }
+    auto sorted = evaluateMot(gt, hyp);
+
+    std::reverse(gt.begin(), gt.end());
+    std::reverse(hyp.begin(), hyp.end());
+    auto reversed = evaluateMot(gt, hyp);
+
+    EXPECT_EQ(sorted.switches, reversed.switches);
+    EXPECT_EQ(sorted.idtp, reversed.idtp);
+    EXPECT_DOUBLE_EQ(sorted.hota(), reversed.hota());
+}
+
+TEST(MetricsTest, PoolMatchesSerial)
+{
+    std::vector<Detection> gt, hyp;
+    for (int frame = 1; frame <= 50; ++frame)
+        for (int id = 0; id < 8; ++id)
+        {
+            gt.push_back(box(frame, id, id * 20.f + frame * 0.1f));
+            hyp.push_back(box(frame, id + (frame / 20) * 100, id * 20.f + frame * 0.1f + (id % 3)));
+        }
+
+    ThreadPool pool(4);
+    auto serial = evaluateMot(gt, hyp);
+    auto parallel = evaluateMot(gt, hyp, {}, &pool);
+
+    EXPECT_DOUBLE_EQ(serial.hota(), parallel.hota());
+    EXPECT_DOUBLE_EQ(serial.assa(), parallel.assa());
+    EXPECT_DOUBLE_EQ(serial.loca(), parallel.loca());
+}
+
+TEST(MetricsTest, SequencesCombineByCounts)
+{
+    std::vector<Detection> gt{box(1, 1, 0.f), box(2, 1, 0.f)};
+    std::vector<Detection> perfect = gt;
+    std::vector<Detection> empty{};
+
+    MotMetrics total = evaluateMot(gt, perfect);
+    total += evaluateMot(gt, empty);
+
+    EXPECT_EQ(total.gt_detections, 4u);
+    EXPECT_EQ(total.gt_tracks, 2);
+    EXPECT_DOUBLE_EQ(total.mota(), 0.5);
+    EXPECT_DOUBLE_EQ(total.idf1(), 2. * 2. / 6.);
+    EXPECT_NEAR(total.deta(), 0.5, 1e-6);
+    EXPECT_NEAR(total.assa(), 1., 1e-6);
+}
+
+// tests/data/metrics: a sequence with an identity switch, a fragmentation, poorly placed
+// and false detections and a mostly lost object, scored by reference.py with motmetrics
+// (eval_motchallenge) and TrackEval
+TEST(MetricsTest, AgreesWithReferenceImplementations)
+{
+    std::filesystem::path data = std::filesystem::path(MOT_TEST_DATA) / "metrics";
+    std::map<std::string, double> expected;
+    std::ifstream file(data / "expected.txt");
+    std::string name;
+    double value;
+    while (file >> name >> value)
+        expected[name] = value;
+    ASSERT_EQ(expected.size(), 13u);
+
+    DetectionFile gt(data / "gt.txt");
+    DetectionFile res(data / "res.txt");
+    auto metrics = evaluateMot(gt.getDetections(), res.getDetections());
+
+    EXPECT_NEAR(metrics.mota(), expected["mota"], 1e-4);
+    EXPECT_NEAR(metrics.motp(), expected["motp"], 1e-4);
+    EXPECT_NEAR(metrics.idf1(), expected["idf1"], 1e-4);
+    EXPECT_EQ(metrics.switches, expected["num_switches"]);
+    EXPECT_EQ(metrics.fragmentations, expected["num_fragmentations"]);
+    EXPECT_EQ(metrics.misses, expected["num_misses"]);
+    EXPECT_EQ(metrics.false_positives, expected["num_false_positives"]);
+    EXPECT_EQ(metrics.mostly_tracked, expected["mostly_tracked"]);
+    EXPECT_EQ(metrics.partially_tracked, expected["partially_tracked"]);
+    EXPECT_EQ(metrics.mostly_lost, expected["mostly_lost"]);
+    EXPECT_NEAR(metrics.hota(), expected["hota"], 1e-4);
+    EXPECT_NEAR(metrics.deta(), expected["deta"], 1e-4);
+    EXPECT_NEAR(metrics.assa(), expected["assa"], 1e-4);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <tracking/multistream.hpp>
+#include <tracking/sort.hpp>
+
+class MultiStreamTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        BaseTrack::count = 0;
+        config.max_time_lost = 3;
+        config.match_thresh = 0.3f;
+    }
+
+    SortConfig config;
+
+    std::vector<std::unique_ptr<BaseTracker>> makeTrackers(size_t n) const
+    {
+        std::vector<std::unique_ptr<BaseTracker>> trackers;
+        for (size_t i = 0; i < n; ++i)
+            trackers.push_back(std::make_unique<Sort>(config));
+        return trackers;
+    }
+
+    // One box per stream moving right by 2px per frame
+    static std::vector<Detection> makeFrame(size_t stream, int frame)
+    {
+        Detection det;
+        det.frame_id = frame;
+        det.bbox = cv::Rect2f(10.f + 2.f * frame, 20.f + 100.f * stream, 50.f, 80.f);
+        det.confidence = 0.9f;
+        return {det};
+    }
+};
+
+TEST_F(MultiStreamTest, EachStreamKeepsItsOwnTracker)
+{
+    MultiStreamTracker engine(makeTrackers(4), 2);
+    ASSERT_EQ(engine.size(), 4u);
+
+    for (int frame = 1; frame <= 10; ++frame)
+        for (size_t s = 0; s < engine.size(); ++s)
+            engine.submit(s, makeFrame(s, frame));
+    engine.wait();
+
+    for (size_t s = 0; s < engine.size(); ++s)
+        EXPECT_EQ(engine.getTracker(s).getTracks().size(), 1u);
+}
+
+TEST_F(MultiStreamTest, FramesKeepSubmissionOrder)
+{
+    MultiStreamTracker engine(makeTrackers(1), 4);
+
+    std::vector<std::future<std::vector<Detection>>> results;
+    for (int frame = 1; frame <= 20; ++frame)
+        results.push_back(engine.submit(0, makeFrame(0, frame)));
+
+    // A single moving object keeps the id of the track created on the first frame
+    int track_id = -1;
+    for (int frame = 1; frame <= 20; ++frame)
+    {
+        auto dets = results[frame - 1].get();
+        ASSERT_EQ(dets.size(), 1u);
+        EXPECT_EQ(dets[0].frame_id, frame);
+        if (frame == 2)
+        {
+            track_id = dets[0].track_id;
+        }
+        else if (frame > 2)
+        {
+            EXPECT_EQ(dets[0].track_id, track_id);
+        }
+    }
+    EXPECT_GT(track_id, 0);
+}
+
+TEST_F(MultiStreamTest, StatsCountProcessedFrames)
+{
+    MultiStreamTracker engine(makeTrackers(2), 2);
+    for (int frame = 1; frame <= 5; ++frame)
+        engine.submit(0, makeFrame(0, frame));
+    engine.submit(1, makeFrame(1, 1));
+    engine.wait();
+
+    auto stats = engine.getStats(0);
+    EXPECT_EQ(stats.frames, 5u);
+    EXPECT_GE(stats.max_latency_ms, stats.mean_update_ms);
+    EXPECT_EQ(engine.getStats(1).frames, 1u);
+}
+
+TEST_F(MultiStreamTest, UnknownStreamThrows)
+{
+    MultiStreamTracker engine(makeTrackers(1), 1);
+    EXPECT_THROW(engine.submit(3, {}), std::out_of_range);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <io/npy.hpp>
+
+#include <fstream>
+#include <vector>
+
+class NpyArrayTest : public testing::Test
+{
+protected:
+    std::filesystem::path path;
+
+    void SetUp() override
+    {
+        path = std::filesystem::path(testing::TempDir()) /
+               (std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + ".npy");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    // Same layout as numpy.save: version 1 header padded to a multiple of 64 bytes
+    void write(const std::string &dict, const std::vector<float> &values, char major = 1) const
+    {
+        size_t prefix = major == 1 ? 10 : 12;
+        std::string header = dict;
+        while ((prefix + header.size() + 1) % 64 != 0)
+            header += ' ';
+        header += '\n';
+
+        std::ofstream file(path, std::ios::binary);
+        file.write("\x93NUMPY", 6);
+        file.put(major);
+        file.put(0);
+        uint32_t size = static_cast<uint32_t>(header.size());
+        file.write(reinterpret_cast<const char *>(&size), major == 1 ? 2 : 4);
+        file << header;
+        file.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(float)));
+    }
+};
+
+TEST_F(NpyArrayTest, ReadsRows)
+{
+    write("{'descr': '<f4', 'fortran_order': False, 'shape': (3, 2), }", {1, 2, 3, 4, 5, 6});
+
+    NpyArray array(path);
+    EXPECT_EQ(array.rows(), 3u);
+    EXPECT_EQ(array.cols(), 2u);
+    EXPECT_FLOAT_EQ(array.row(0)[0], 1.f);
+    EXPECT_FLOAT_EQ(array.row(1)[1], 4.f);
+    EXPECT_FLOAT_EQ(array.row(2)[0], 5.f);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(array.row(0).data()) % 64, 0u);
+}
+
+TEST_F(NpyArrayTest, ReadsVersion2)
+{
+    write("{'descr': '<f4', 'fortran_order': False, 'shape': (1, 3), }", {7, 8, 9}, 2);
+
+    NpyArray array(path);
+    ASSERT_EQ(array.rows(), 1u);
+    EXPECT_FLOAT_EQ(array.row(0)[2], 9.f);
+}
+
+TEST_F(NpyArrayTest, RejectsUnsupportedArrays)
+{
+    write("{'descr': '<f8', 'fortran_order': False, 'shape': (1, 1), }", {0, 0});
+    EXPECT_THROW(NpyArray array(path), std::runtime_error);
+
+    write("{'descr': '<f4', 'fortran_order': True, 'shape': (1, 1), }", {0});
+    EXPECT_THROW(NpyArray array(path), std::runtime_error);
+
+    write("{'descr': '<f4', 'fortran_order': False, 'shape': (4,), }", {0, 0, 0, 0});
+    EXPECT_THROW(NpyArray array(path), std::runtime_error);
+
+    write("{'descr': '<f4', 'fortran_order': False, 'shape': (4, 2), }", {0, 0});
+    EXPECT_THROW(NpyArray array(path), std::runtime_error);
+}
+
+TEST_F(NpyArrayTest, RejectsOverflowingShape)
+{
+    // 2^62 x 4 floats wraps to 0 bytes in a size_t
+    write("{'descr': '<f4', 'fortran_order': False, 'shape': (4611686018427387904, 4), }", {0, 0});
+    EXPECT_THROW(NpyArray array(path), std::runtime_error);
+}
+
+TEST_F(NpyArrayTest, WriteRoundTrip)
+{
+    std::vector<float> values{1.5f, -2.f, 3.f, 4.f, 5.f, 6.25f};
+    writeNpy(path, values, 3);
+
+    NpyArray array(path);
+    ASSERT_EQ(array.rows(), 2u);
+    ASSERT_EQ(array.cols(), 3u);
+    EXPECT_FLOAT_EQ(array.row(0)[1], -2.f);
+    EXPECT_FLOAT_EQ(array.row(1)[2], 6.25f);
+}
+
+TEST_F(NpyArrayTest, WriteRejectsPartialRow)
+{
+    std::vector<float> values{1.f, 2.f, 3.f};
+    EXPECT_THROW(writeNpy(path, values, 2), std::invalid_argument);
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <tracking/botsort.hpp>
+#include <tracking/profiler.hpp>
+#include <tracking/sort.hpp>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#endif
+
+// Trackers report nothing when profiling is compiled out
+#ifdef MOT_NO_PROFILING
+#define SKIP_WITHOUT_PROFILING() GTEST_SKIP() << "built with MOT_NO_PROFILING"
+#else
+#define SKIP_WITHOUT_PROFILING()
+#endif
+
+static Detection makeDet(float x, float y, float conf = 0.9f)
+{
+    Detection det;
+    det.bbox = cv::Rect2f(x, y, 40.f, 80.f);
+    det.confidence = conf;
+    return det;
+}
+
+TEST(ProfilerTest, HistogramQuantiles)
+{
+    LatencyHistogram histogram;
+    for (uint64_t ns = 1; ns <= 1000; ++ns)
+        histogram.record(ns * 1000);
+
+    EXPECT_EQ(histogram.count(), 1000u);
+    EXPECT_EQ(histogram.max(), 1000000u);
+    EXPECT_NEAR(histogram.mean(), 500500., 1e-6);
+
+    // Bucket upper bounds are at most a quarter above the true value
+    EXPECT_GE(histogram.quantile(0.5), 500000.);
+    EXPECT_LE(histogram.quantile(0.5), 500000. * 1.25);
+    EXPECT_GE(histogram.quantile(0.99), 990000.);
+    EXPECT_LE(histogram.quantile(0.99), 1000000.);
+    EXPECT_DOUBLE_EQ(histogram.quantile(1.), 1000000.);
+}
+
+TEST(ProfilerTest, HistogramSmallValuesAreExact)
+{
+    LatencyHistogram histogram;
+    for (uint64_t ns : {0, 1, 2, 3, 4, 5, 6, 7})
+        histogram.record(ns);
+    EXPECT_DOUBLE_EQ(histogram.quantile(0.5), 4.);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_DOUBLE_EQ(histogram.quantile(0.5), 0.);
+}
+
+TEST(ProfilerTest, SortReportsStages)
+{
+    SKIP_WITHOUT_PROFILING();
+
+    auto profiler = std::make_shared<TrackerProfiler>();
+    Sort tracker(SortConfig{});
+    tracker.setProfiler(profiler);
+
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        std::vector<Detection> dets{makeDet(10.f + frame, 10.f), makeDet(200.f, 10.f), makeDet(400.f, 10.f)};
+        if (frame == 4)
+            dets.pop_back();
+        tracker.update(dets);
+    }
+
+    EXPECT_EQ(profiler->getStats(TrackerStage::Predict).count, 5u);
+    EXPECT_EQ(profiler->getStats(TrackerStage::Prune).count, 5u);
+
+    // No tracks to match on the first frame
+    auto cost = profiler->getStats(TrackerStage::Cost);
+    EXPECT_EQ(cost.count, 4u);
+    EXPECT_EQ(cost.matrices, 4u);
+    EXPECT_EQ(cost.max_rows, 3u);
+    EXPECT_EQ(cost.max_cols, 3u);
+    EXPECT_LE(cost.p50_us, cost.max_us);
+
+    auto counts = profiler->getTrackCounts();
+    EXPECT_EQ(counts.frames, 5u);
+    EXPECT_EQ(counts.tracked, 2u);
+    EXPECT_EQ(counts.lost, 1u);
+    EXPECT_EQ(counts.max_total, 3u);
+}
+
+TEST(ProfilerTest, BotSortReportsEveryAssociation)
+{
+    SKIP_WITHOUT_PROFILING();
+
+    auto profiler = std::make_shared<TrackerProfiler>();
+    BotSort tracker(BotSortConfig{});
+    tracker.setProfiler(profiler);
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        std::vector<Detection> dets{makeDet(10.f, 10.f), makeDet(200.f, 10.f, 0.3f)};
+        tracker.update(dets);
+    }
+
+    EXPECT_EQ(profiler->getStats(TrackerStage::Predict).count, 3u);
+    EXPECT_EQ(profiler->getStats(TrackerStage::Create).count, 3u);
+    EXPECT_GT(profiler->getStats(TrackerStage::Solve).matrices, 0u);
+    EXPECT_EQ(profiler->getTrackCounts().frames, 3u);
+}
+
+TEST(ProfilerTest, ResetClearsEverything)
+{
+    SKIP_WITHOUT_PROFILING();
+
+    auto profiler = std::make_shared<TrackerProfiler>();
+    Sort tracker(SortConfig{});
+    tracker.setProfiler(profiler);
+    std::vector<Detection> dets{makeDet(10.f, 10.f)};
+    tracker.update(dets);
+    tracker.update(dets);
+
+    profiler->reset();
+    EXPECT_EQ(profiler->getStats(TrackerStage::Cost).count, 0u);
+    EXPECT_EQ(profiler->getStats(TrackerStage::Cost).matrices, 0u);
+    EXPECT_EQ(profiler->getTrackCounts().frames, 0u);
+
+    // Detaching stops recording
+    tracker.setProfiler(nullptr);
+    tracker.update(dets);
+    EXPECT_EQ(profiler->getStats(TrackerStage::Predict).count, 0u);
+}
+
+TEST(ProfilerTest, CountersDegradeGracefully)
+{
+    SKIP_WITHOUT_PROFILING();
+
+    // Hardware counters are often unavailable (containers, VMs): tracking goes on either way
+    auto profiler = std::make_shared<TrackerProfiler>();
+    bool enabled = profiler->enableCounters();
+    EXPECT_EQ(enabled, profiler->hasCounters());
+    EXPECT_EQ(enabled, profiler->getCounterError().empty());
+
+    Sort tracker(SortConfig{});
+    tracker.setProfiler(profiler);
+    std::vector<Detection> dets{makeDet(10.f, 10.f)};
+    tracker.update(dets);
+    tracker.update(dets);
+
+    auto stats = profiler->getStats(TrackerStage::Predict);
+    EXPECT_EQ(stats.count, 2u);
+    EXPECT_EQ(stats.has_counters, enabled);
+}
+
+#ifdef __linux__
+// Software events go through the same perf_event_open group as the hardware ones
+static const std::array<PerfEvent, NUM_PERF_COUNTERS> SOFTWARE_EVENTS = {{
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS},
+}};
+
+TEST(ProfilerTest, CountersPerStage)
+{
+    SKIP_WITHOUT_PROFILING();
+
+    auto profiler = std::make_shared<TrackerProfiler>();
+    if (!profiler->enableCounters(SOFTWARE_EVENTS))
+        GTEST_SKIP() << "perf_event_open unavailable: " << profiler->getCounterError();
+
+    Sort tracker(SortConfig{});
+    tracker.setProfiler(profiler);
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        std::vector<Detection> dets;
+        for (int i = 0; i < 200; ++i)
+            dets.push_back(makeDet(50.f * i, 10.f));
+        tracker.update(dets);
+    }
+
+    // Task clock (ns) stands in for cycles
+    auto solve = profiler->getStats(TrackerStage::Solve);
+    EXPECT_TRUE(solve.has_counters);
+    EXPECT_GT(solve.cycles, 0.);
+
+    profiler->reset();
+    EXPECT_FALSE(profiler->getStats(TrackerStage::Solve).has_counters);
+}
+#endif
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <synthetic/crowd.hpp>
+#include <tracking/botsort.hpp>
+#include <tracking/recorder.hpp>
+#include <tracking/sort.hpp>
+
+#include <fstream>
+
+class RecorderTest : public testing::Test
+{
+protected:
+    std::filesystem::path path;
+
+    void SetUp() override
+    {
+        path = std::filesystem::path(testing::TempDir()) /
+               (std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + ".motr");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    // Records `frames` of a seeded crowd through a BoT-SORT tracker
+    void record(size_t frames)
+    {
+        CrowdConfig config;
+        config.num_objects = 30;
+        config.feature_dim = 16;
+        config.miss_rate = 0.1f;
+        config.seed = 7;
+        CrowdGenerator crowd(config);
+
+        RecordingTracker recorder(std::make_unique<BotSort>(BotSortConfig{}), path);
+        std::vector<Detection> detections;
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            crowd.next(detections);
+            recorder.update(detections);
+        }
+        EXPECT_EQ(recorder.size(), frames);
+        EXPECT_FALSE(recorder.getTracks().empty());
+    }
+};
+
+TEST_F(RecorderTest, ReadsBackInputsAndIds)
+{
+    std::vector<Detection> input(2);
+    input[0].frame_id = 1;
+    input[0].class_id = 3;
+    input[0].confidence = 0.8f;
+    input[0].bbox = cv::Rect2f(10.f, 20.f, 30.f, 60.f);
+    input[0].features = {0.6f, 0.8f};
+    input[1].frame_id = 1;
+    input[1].confidence = 0.9f;
+    input[1].bbox = cv::Rect2f(200.f, 20.f, 30.f, 60.f);
+    {
+        RecordingTracker recorder(std::make_unique<Sort>(SortConfig{}), path);
+        recorder.update(input);
+        std::vector<Detection> empty;
+        recorder.update(empty);
+    }
+
+    RecordingReader reader(path);
+    RecordedUpdate update;
+    ASSERT_TRUE(reader.next(update));
+    ASSERT_EQ(update.detections.size(), 2u);
+    EXPECT_EQ(update.detections[0].class_id, 3);
+    EXPECT_EQ(update.detections[0].bbox, input[0].bbox);
+    EXPECT_EQ(update.detections[0].features, input[0].features);
+    EXPECT_EQ(update.detections[0].track_id, -1);
+    EXPECT_TRUE(update.detections[1].features.empty());
+    EXPECT_EQ(update.track_ids, (std::vector<int>{input[0].track_id, input[1].track_id}));
+    EXPECT_GT(update.update_ns, 0u);
+
+    ASSERT_TRUE(reader.next(update));
+    EXPECT_TRUE(update.detections.empty());
+    EXPECT_FALSE(reader.next(update));
+    EXPECT_FALSE(reader.truncated());
+}
+
+TEST_F(RecorderTest, ReplayReproducesIds)
+{
+    record(40);
+
+    // Ids continue from the recording: they only match up to a renaming
+    BotSort tracker(BotSortConfig{});
+    auto result = replayRecording(path, tracker);
+    EXPECT_EQ(result.updates, 40u);
+    EXPECT_GT(result.detections, 0u);
+    EXPECT_TRUE(result.identical());
+    EXPECT_EQ(result.first_mismatch, -1);
+    EXPECT_EQ(result.replayed_ms.size(), 40u);
+    EXPECT_EQ(result.recorded_ms.size(), 40u);
+}
+
+TEST_F(RecorderTest, ReplayReportsDivergence)
+{
+    record(40);
+
+    // A tracker that never confirms anything emits different ids
+    BotSortConfig config;
+    config.new_track_thresh = 1.1f;
+    BotSort tracker(config);
+    auto result = replayRecording(path, tracker);
+    EXPECT_FALSE(result.identical());
+    EXPECT_GE(result.first_mismatch, 0);
+    EXPECT_GT(result.mismatched_updates, 0u);
+}
+
+TEST_F(RecorderTest, TruncatedRecordingStopsAtLastCompleteUpdate)
+{
+    record(10);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+
+    BotSort tracker(BotSortConfig{});
+    auto result = replayRecording(path, tracker);
+    EXPECT_EQ(result.updates, 9u);
+    EXPECT_TRUE(result.truncated);
+    EXPECT_TRUE(result.identical());
+}
+
+TEST_F(RecorderTest, RejectsOtherFiles)
+{
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "MOTB and some more bytes";
+    }
+    EXPECT_THROW(RecordingReader reader(path), std::runtime_error);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <io/result_writer.hpp>
+#include <io/trajectory_file.hpp>
+
+#include <fstream>
+#include <sstream>
+
+class ResultWriterTest : public testing::Test
+{
+protected:
+    std::filesystem::path path;
+
+    void SetUp() override
+    {
+        path = std::filesystem::path(testing::TempDir()) /
+               (std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + ".out");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    static Detection makeDet(int frame_id, int track_id, float x, float y, float w, float h, float conf)
+    {
+        Detection det;
+        det.frame_id = frame_id;
+        det.track_id = track_id;
+        det.class_id = 1;
+        det.bbox = cv::Rect2f(x, y, w, h);
+        det.confidence = conf;
+        return det;
+    }
+
+    // Reference formatting: the library's operator<<, as used by mot-convert
+    static std::string expectedLine(const Detection &det)
+    {
+        std::ostringstream oss;
+        oss << det << "\n";
+        return oss.str();
+    }
+
+    std::string readAll() const
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), {});
+    }
+};
+
+TEST_F(ResultWriterTest, TextMatchesStreamFormatting)
+{
+    std::vector<Detection> detections = {
+        makeDet(1, 3, 10.f, 20.5f, 30.25f, 40.f, 0.9f),
+        makeDet(1, 12, 1234.5678f, -1.5f, 0.001f, 1e7f, 1.f),
+        makeDet(2, 4, 0.f, 1.f / 3.f, 100.f, 2.f / 3.f, 0.123456789f),
+    };
+
+    std::string expected;
+    for (const auto &det : detections)
+        expected += expectedLine(det);
+
+    {
+        ResultWriter writer(path);
+        writer.write(detections);
+    }
+    EXPECT_EQ(readAll(), expected);
+}
+
+TEST_F(ResultWriterTest, BackgroundWriterKeepsOrder)
+{
+    // A small buffer forces many chunks through the background thread
+    std::string expected;
+    {
+        ResultWriter writer(path, ResultFormat::Text, true, 256);
+        std::vector<Detection> detections;
+        for (int frame_id = 1; frame_id <= 200; ++frame_id)
+        {
+            detections.clear();
+            for (int i = 0; i < 10; ++i)
+            {
+                detections.push_back(makeDet(frame_id, i, frame_id * 1.5f, i * 2.f, 10.f, 20.f, 0.5f));
+                expected += expectedLine(detections.back());
+            }
+            writer.write(detections);
+        }
+        writer.flush();
+        EXPECT_EQ(readAll(), expected);
+
+        // Whatever is still buffered is written on destruction
+        writer.write(detections);
+        for (const auto &det : detections)
+            expected += expectedLine(det);
+    }
+    EXPECT_EQ(readAll(), expected);
+}
+
+TEST_F(ResultWriterTest, BinaryTrajectories)
+{
+    {
+        ResultWriter writer(path, ResultFormat::Binary, true);
+        writer.write(std::vector<Detection>{makeDet(1, 7, 1.f, 2.f, 3.f, 4.f, 0.5f)});
+        writer.write(std::vector<Detection>{});
+        writer.write(std::vector<Detection>{makeDet(3, 8, 5.f, 6.f, 7.f, 8.f, 0.25f),
+                                            makeDet(3, 7, 9.f, 10.f, 11.f, 12.f, 0.75f)});
+    }
+
+    TrajectoryFile file(path);
+    auto rows = file.getRows();
+    ASSERT_EQ(rows.size(), 3u);
+    EXPECT_EQ(rows[0].frame_id, 1);
+    EXPECT_EQ(rows[0].track_id, 7);
+    EXPECT_EQ(rows[0].class_id, 1);
+    EXPECT_FLOAT_EQ(rows[0].h, 4.f);
+    EXPECT_EQ(rows[2].frame_id, 3);
+    EXPECT_EQ(rows[2].track_id, 7);
+    EXPECT_FLOAT_EQ(rows[2].x, 9.f);
+    EXPECT_FLOAT_EQ(rows[2].confidence, 0.75f);
+}
+
+TEST_F(ResultWriterTest, InvalidPathThrows)
+{
+    EXPECT_THROW(ResultWriter writer(path / "missing" / "out.txt"), std::system_error);
+}
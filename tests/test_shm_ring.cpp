@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <io/shm_ring.hpp>
+
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+class ShmRingTest : public testing::Test
+{
+protected:
+    std::string name;
+
+    void SetUp() override
+    {
+        name = "mot_test_" + std::to_string(::getpid()) + "_" +
+               testing::UnitTest::GetInstance()->current_test_info()->name();
+    }
+};
+
+TEST_F(ShmRingTest, RoundTripInPlace)
+{
+    ShmRing producer = ShmRing::create(name, 2, 4, 3);
+    ShmRing consumer = ShmRing::open(name);
+    EXPECT_EQ(consumer.getNumSlots(), 2u);
+    EXPECT_EQ(consumer.getMaxDetections(), 4u);
+    EXPECT_EQ(consumer.getFeatureDim(), 3u);
+
+    ShmFrame frame;
+    ASSERT_TRUE(producer.tryAcquire(frame));
+    ASSERT_EQ(frame.detections.size(), 4u);
+    frame.frame_id = 7;
+    frame.detections[0] = {1.f, 2.f, 3.f, 4.f, 0.9f, 1, -1, 0};
+    frame.detections[1] = {5.f, 6.f, 7.f, 8.f, 0.8f, 2, -1, 0};
+    for (size_t i = 0; i < 6; ++i)
+        frame.features[i] = static_cast<float>(i);
+    producer.publish(frame, 2);
+
+    ShmFrame received;
+    ASSERT_TRUE(consumer.tryReceive(received));
+    EXPECT_EQ(received.frame_id, 7);
+    ASSERT_EQ(received.detections.size(), 2u);
+    EXPECT_FLOAT_EQ(received.detections[1].x, 5.f);
+    EXPECT_EQ(received.detections[1].class_id, 2);
+    ASSERT_EQ(received.features.size(), 6u);
+    EXPECT_FLOAT_EQ(received.features[4], 4.f);
+
+    // Nothing to collect before the consumer completes
+    ShmFrame done;
+    EXPECT_FALSE(producer.tryCollect(done));
+
+    received.detections[0].track_id = 10;
+    received.detections[1].track_id = 11;
+    consumer.complete(received);
+
+    ASSERT_TRUE(producer.tryCollect(done));
+    ASSERT_EQ(done.detections.size(), 2u);
+    EXPECT_EQ(done.detections[0].track_id, 10);
+    EXPECT_EQ(done.detections[1].track_id, 11);
+    EXPECT_GE(done.processed_ns, done.published_ns);
+}
+
+TEST_F(ShmRingTest, FullRingRejectsAcquire)
+{
+    ShmRing producer = ShmRing::create(name, 2, 1, 0);
+    ShmRing consumer = ShmRing::open(name);
+
+    ShmFrame frame;
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_TRUE(producer.tryAcquire(frame));
+        producer.publish(frame, 1);
+    }
+    EXPECT_FALSE(producer.tryAcquire(frame));
+
+    // A slot is only free again once its results are collected
+    ShmFrame received;
+    ASSERT_TRUE(consumer.tryReceive(received));
+    consumer.complete(received);
+    EXPECT_FALSE(producer.tryAcquire(frame));
+
+    ShmFrame done;
+    ASSERT_TRUE(producer.tryCollect(done));
+    EXPECT_TRUE(producer.tryAcquire(frame));
+}
+
+TEST_F(ShmRingTest, ConcurrentProducerConsumer)
+{
+    constexpr int frames = 2000;
+    ShmRing producer = ShmRing::create(name, 4, 8, 0);
+    ShmRing consumer = ShmRing::open(name);
+
+    std::thread tracker([&consumer]()
+                        {
+        ShmFrame frame;
+        while (!consumer.finished())
+        {
+            if (!consumer.tryReceive(frame))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            for (auto &det : frame.detections)
+                det.track_id = frame.frame_id * 10 + det.class_id;
+            consumer.complete(frame);
+        } });
+
+    bool consistent = true;
+    int collected = 0;
+    auto collect = [&]()
+    {
+        ShmFrame done;
+        while (producer.tryCollect(done))
+        {
+            consistent &= done.frame_id == collected + 1 && done.detections.size() == static_cast<size_t>(done.frame_id % 8 + 1);
+            for (const auto &det : done.detections)
+                consistent &= det.track_id == done.frame_id * 10 + det.class_id;
+            collected++;
+        }
+    };
+
+    for (int frame_id = 1; frame_id <= frames; ++frame_id)
+    {
+        ShmFrame frame;
+        while (!producer.tryAcquire(frame))
+        {
+            collect();
+            std::this_thread::yield();
+        }
+        frame.frame_id = frame_id;
+        size_t count = static_cast<size_t>(frame_id % 8 + 1);
+        for (size_t i = 0; i < count; ++i)
+            frame.detections[i] = {0.f, 0.f, 1.f, 1.f, 1.f, static_cast<int32_t>(i), -1, 0};
+        producer.publish(frame, count);
+    }
+    producer.close();
+
+    while (collected < frames)
+    {
+        collect();
+        std::this_thread::yield();
+    }
+    tracker.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(collected, frames);
+}
+
+TEST_F(ShmRingTest, OpenMissingRingThrows)
+{
+    EXPECT_THROW(ShmRing::open(name), std::system_error);
+}
+
+TEST_F(ShmRingTest, TryOpenWaitsForInitialisation)
+{
+    // Segment created by a producer that has not sized or filled it yet
+    std::string segment = "/" + name;
+    int fd = ::shm_open(segment.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    ASSERT_GE(fd, 0);
+    EXPECT_FALSE(ShmRing::tryOpen(name).has_value());
+    EXPECT_THROW(ShmRing::open(name), std::runtime_error);
+
+    ASSERT_EQ(::ftruncate(fd, 4096), 0);
+    EXPECT_FALSE(ShmRing::tryOpen(name).has_value());
+    ::close(fd);
+    ::shm_unlink(segment.c_str());
+
+    ShmRing producer = ShmRing::create(name, 2, 1, 0);
+    auto consumer = ShmRing::tryOpen(name);
+    ASSERT_TRUE(consumer.has_value());
+    EXPECT_EQ(consumer->getNumSlots(), 2u);
+}
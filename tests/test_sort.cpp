@@ -140,3 +140,107 @@ TEST_F(SortTest, MatchedTrackResetsTimeSinceUpdate)
     tracker.update(dets);               // re-match, reset to 0
     EXPECT_EQ(tracker.getTracks()[0]->time_since_update, 0u);
 }
+
+TEST_F(SortTest, ClassAgnosticByDefault)
+{
+    Sort tracker(config);
+    std::vector<Detection> dets = {makeDet(10, 20, 100, 50)};
+    dets[0].class_id = 1;
+    tracker.update(dets);
+
+    dets[0].class_id = 2;
+    tracker.update(dets);
+    EXPECT_EQ(tracker.getTracks().size(), 1u);
+    EXPECT_GT(dets[0].track_id, 0);
+}
+
+TEST_F(SortTest, ClassAwareDoesNotMatchAcrossClasses)
+{
+    config.class_aware = true;
+    Sort tracker(config);
+    std::vector<Detection> dets = {makeDet(10, 20, 100, 50)};
+    dets[0].class_id = 1;
+    tracker.update(dets);
+
+    // Same box, other class: the existing track must not be reused
+    std::vector<Detection> other = {makeDet(10, 20, 100, 50)};
+    other[0].class_id = 2;
+    tracker.update(other);
+    EXPECT_EQ(tracker.getTracks().size(), 2u);
+
+    // Same class matches again
+    tracker.update(dets);
+    EXPECT_EQ(tracker.getTracks()[0]->class_id, 1);
+    EXPECT_EQ(dets[0].track_id, tracker.getTracks()[0]->id);
+}
+
+TEST_F(SortTest, ClassAwareParallelPartitionsMatchSequential)
+{
+    config.class_aware = true;
+
+    // Two large classes interleaved on a grid, shifted by one pixel per frame
+    auto makeFrame = [](int frame)
+    {
+        std::vector<Detection> dets;
+        for (int k = 0; k < 200; ++k)
+        {
+            auto det = makeDet(static_cast<float>(60 * (k % 20) + frame), static_cast<float>(60 * (k / 20)), 40, 40);
+            det.class_id = k % 2;
+            dets.push_back(det);
+        }
+        return dets;
+    };
+
+    Sort sequential(config);
+    Sort parallel(config);
+    parallel.setThreadPool(std::make_shared<ThreadPool>(4));
+
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        auto seq_dets = makeFrame(frame);
+        auto par_dets = makeFrame(frame);
+        sequential.update(seq_dets);
+        parallel.update(par_dets);
+
+        ASSERT_EQ(sequential.getTracks().size(), parallel.getTracks().size());
+        for (size_t i = 0; i < seq_dets.size(); ++i)
+            EXPECT_EQ(seq_dets[i].track_id > 0, par_dets[i].track_id > 0);
+    }
+}
+
+TEST_F(SortTest, MultiThreadedUpdateIsDeterministic)
+{
+    // Dense grid jittered per frame, with some objects dropping out
+    auto makeFrame = [](int frame)
+    {
+        std::vector<Detection> dets;
+        for (int k = 0; k < 300; ++k)
+        {
+            if ((k + frame) % 7 == 0)
+                continue;
+            float jitter = static_cast<float>((k * 31 + frame * 17) % 5);
+            dets.push_back(makeDet(50.f * (k % 25) + frame + jitter, 50.f * (k / 25) + jitter, 30, 40));
+        }
+        return dets;
+    };
+
+    auto run = [&](size_t num_threads)
+    {
+        BaseTrack::count = 0;
+        config.num_threads = num_threads;
+        Sort tracker(config);
+        std::vector<int> ids;
+        for (int frame = 0; frame < 6; ++frame)
+        {
+            auto dets = makeFrame(frame);
+            tracker.update(dets);
+            for (const auto &det : dets)
+                ids.push_back(det.track_id);
+            for (const auto &track : tracker.getTracks())
+                ids.push_back(track->id);
+        }
+        return ids;
+    };
+
+    EXPECT_EQ(run(1), run(4));
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <parallel/spsc_queue.hpp>
+
+#include <memory>
+#include <thread>
+
+TEST(SpscQueueTest, CapacityIsPowerOfTwo)
+{
+    EXPECT_EQ(SpscQueue<int>(0).capacity(), 1u);
+    EXPECT_EQ(SpscQueue<int>(5).capacity(), 8u);
+    EXPECT_EQ(SpscQueue<int>(16).capacity(), 16u);
+}
+
+TEST(SpscQueueTest, TryPushFailsWhenFull)
+{
+    SpscQueue<int> queue(2);
+    int value = 1;
+    EXPECT_TRUE(queue.tryPush(value));
+    value = 2;
+    EXPECT_TRUE(queue.tryPush(value));
+    value = 3;
+    EXPECT_FALSE(queue.tryPush(value));
+
+    EXPECT_EQ(queue.tryPop(), 1);
+    EXPECT_TRUE(queue.tryPush(value));
+    EXPECT_EQ(queue.tryPop(), 2);
+    EXPECT_EQ(queue.tryPop(), 3);
+    EXPECT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(SpscQueueTest, MoveOnlyValues)
+{
+    SpscQueue<std::unique_ptr<int>> queue(4);
+    queue.push(std::make_unique<int>(7));
+    auto value = queue.pop();
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*value, 7);
+}
+
+TEST(SpscQueueTest, ProducerConsumerKeepOrder)
+{
+    constexpr int count = 100000;
+    SpscQueue<int> queue(8);
+
+    std::thread producer([&queue]()
+                         {
+        for (int i = 0; i < count; ++i)
+            queue.push(i); });
+
+    bool ordered = true;
+    for (int i = 0; i < count; ++i)
+        ordered &= queue.pop() == i;
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_FALSE(queue.tryPop().has_value());
+}
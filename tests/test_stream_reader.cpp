@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <io/stream_reader.hpp>
+
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+class StreamReaderTest : public testing::Test
+{
+protected:
+    int fds[2] = {-1, -1};
+
+    void SetUp() override
+    {
+        ASSERT_EQ(::pipe(fds), 0);
+    }
+
+    void TearDown() override
+    {
+        ::close(fds[0]);
+        if (fds[1] >= 0)
+            ::close(fds[1]);
+    }
+
+    void send(const std::string &data) const
+    {
+        ASSERT_EQ(::write(fds[1], data.data(), data.size()), static_cast<ssize_t>(data.size()));
+    }
+
+    void closeWriter()
+    {
+        ::close(fds[1]);
+        fds[1] = -1;
+    }
+};
+
+TEST_F(StreamReaderTest, SplitsFramesOnEmptyLines)
+{
+    StreamReader reader(fds[0]);
+    send("1,-1,10,20,30,40,0.9,-1,-1,-1\n1,-1,50,60,70,80,0.8,-1,-1,-1\n\n2,-1,1,2,3,4,0.7,-1,-1,-1\n\n");
+
+    EXPECT_TRUE(reader.poll(1000));
+
+    StreamReader::Frame frame;
+    ASSERT_TRUE(reader.nextFrame(frame));
+    ASSERT_EQ(frame.detections.size(), 2u);
+    EXPECT_EQ(frame.detections[1].frame_id, 1);
+    EXPECT_FLOAT_EQ(frame.detections[1].bbox.x, 50.f);
+
+    ASSERT_TRUE(reader.nextFrame(frame));
+    ASSERT_EQ(frame.detections.size(), 1u);
+    EXPECT_EQ(frame.detections[0].frame_id, 2);
+
+    EXPECT_FALSE(reader.nextFrame(frame));
+}
+
+TEST_F(StreamReaderTest, WaitsForTheTerminator)
+{
+    StreamReader reader(fds[0]);
+    send("1,-1,10,20,30,40,0.9,-1,-1,-1\n1,-1,50,6");
+    EXPECT_TRUE(reader.poll(1000));
+
+    StreamReader::Frame frame;
+    EXPECT_FALSE(reader.nextFrame(frame));
+
+    // Nothing new to read, poll times out
+    EXPECT_TRUE(reader.poll(0));
+    EXPECT_FALSE(reader.nextFrame(frame));
+
+    send("0,70,80,0.8,-1,-1,-1\n\n");
+    EXPECT_TRUE(reader.poll(1000));
+    ASSERT_TRUE(reader.nextFrame(frame));
+    ASSERT_EQ(frame.detections.size(), 2u);
+    EXPECT_FLOAT_EQ(frame.detections[1].bbox.y, 60.f);
+}
+
+TEST_F(StreamReaderTest, EmptyFramesAndClose)
+{
+    StreamReader reader(fds[0]);
+    send("\n3,-1,1,2,3,4,0.7,-1,-1,-1\nnot a detection\n3,-1,5,6,7,8,0.7,-1,-1,-1");
+    closeWriter();
+
+    while (reader.poll(1000))
+    {
+    }
+    EXPECT_TRUE(reader.closed());
+    EXPECT_EQ(reader.getSkippedLines(), 1u);
+
+    StreamReader::Frame frame;
+    ASSERT_TRUE(reader.nextFrame(frame));
+    EXPECT_TRUE(frame.detections.empty());
+
+    // The unterminated last frame is returned once the stream is closed
+    ASSERT_TRUE(reader.nextFrame(frame));
+    ASSERT_EQ(frame.detections.size(), 2u);
+    EXPECT_FLOAT_EQ(frame.detections[1].bbox.width, 7.f);
+    EXPECT_FALSE(reader.nextFrame(frame));
+}
+
+TEST_F(StreamReaderTest, RestoresBlockingMode)
+{
+    {
+        StreamReader reader(fds[0]);
+        EXPECT_TRUE(::fcntl(fds[0], F_GETFL) & O_NONBLOCK);
+    }
+    EXPECT_FALSE(::fcntl(fds[0], F_GETFL) & O_NONBLOCK);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <parallel/thread_pool.hpp>
+
+TEST(ThreadPoolTest, SubmitReturnsResult)
+{
+    ThreadPool pool(2);
+    auto result = pool.submit([]()
+                              { return 42; });
+    EXPECT_EQ(result.get(), 42);
+}
+
+TEST(ThreadPoolTest, SubmitPropagatesException)
+{
+    ThreadPool pool(2);
+    auto result = pool.submit([]() -> int
+                              { throw std::runtime_error("boom"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, ManyTasksAllRun)
+{
+    ThreadPool pool(4);
+    std::atomic<int> counter{0};
+    std::vector<std::future<void>> results;
+    for (int i = 0; i < 1000; ++i)
+        results.push_back(pool.submit([&counter]()
+                                      { counter++; }));
+    for (auto &result : results)
+        result.get();
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+    ThreadPool pool(4);
+    std::vector<int> visits(1000, 0);
+    pool.parallelFor(0, visits.size(), [&visits](size_t i)
+                     { visits[i]++; });
+    for (int v : visits)
+        EXPECT_EQ(v, 1);
+}
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock)
+{
+    // More outer tasks than workers, each blocking on an inner parallelFor
+    ThreadPool pool(2);
+    std::atomic<int> counter{0};
+    pool.parallelFor(0, 8, [&pool, &counter](size_t)
+                     { pool.parallelFor(0, 100, [&counter](size_t)
+                                        { counter++; }); });
+    EXPECT_EQ(counter.load(), 800);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrows)
+{
+    ThreadPool pool(2);
+    EXPECT_THROW(pool.parallelFor(0, 100, [](size_t i)
+                                  { if (i == 57) throw std::runtime_error("boom"); }),
+                 std::runtime_error);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <tracking/tiled.hpp>
+#include <tracking/sort.hpp>
+
+class TiledTrackerTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        BaseTrack::count = 0;
+        sort_config.max_time_lost = 2;
+        sort_config.match_thresh = 0.3f;
+        config.tile_width = 100.f;
+        config.tile_height = 100.f;
+        config.overlap = 20.f;
+        config.num_threads = 2;
+    }
+
+    SortConfig sort_config;
+    TilingConfig config;
+
+    TiledTracker makeTracker() const
+    {
+        auto sort_config_copy = sort_config;
+        return TiledTracker(config, [sort_config_copy]()
+                            { return std::make_unique<Sort>(sort_config_copy); });
+    }
+
+    static Detection makeDet(float x, float y, float w, float h)
+    {
+        Detection det;
+        det.bbox = cv::Rect2f(x, y, w, h);
+        det.confidence = 0.9f;
+        return det;
+    }
+};
+
+TEST_F(TiledTrackerTest, InvalidConfigThrows)
+{
+    config.tile_width = 0.f;
+    EXPECT_THROW(makeTracker(), std::invalid_argument);
+
+    config.tile_width = 100.f;
+    config.overlap = 60.f;
+    EXPECT_THROW(makeTracker(), std::invalid_argument);
+}
+
+TEST_F(TiledTrackerTest, TrackKeepsIdAcrossTileBorder)
+{
+    auto tracker = makeTracker();
+
+    // Moves from the first tile into the second one, 3px per frame
+    std::set<int> ids;
+    for (int frame = 0; frame < 40; ++frame)
+    {
+        std::vector<Detection> dets = {makeDet(40.f + 3.f * frame, 40.f, 10.f, 10.f)};
+        tracker.update(dets);
+        if (frame > 0)
+            ids.insert(dets[0].track_id);
+    }
+
+    ASSERT_EQ(ids.size(), 1u);
+    EXPECT_GT(*ids.begin(), 0);
+}
+
+TEST_F(TiledTrackerTest, DistantObjectsGetDistinctIds)
+{
+    auto tracker = makeTracker();
+    std::vector<Detection> dets;
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        dets = {makeDet(45.f, 45.f, 10.f, 10.f), makeDet(545.f, 345.f, 10.f, 10.f)};
+        tracker.update(dets);
+    }
+
+    EXPECT_EQ(tracker.getTileCount(), 2u);
+    EXPECT_GT(dets[0].track_id, 0);
+    EXPECT_GT(dets[1].track_id, 0);
+    EXPECT_NE(dets[0].track_id, dets[1].track_id);
+}
+
+TEST_F(TiledTrackerTest, ObjectsCrossingInOverlapGetDistinctIds)
+{
+    auto tracker = makeTracker();
+    auto makeBox = [](float cx, float cy)
+    { return makeDet(cx - 10.f, cy - 10.f, 20.f, 20.f); };
+
+    // The first object walks from the first tile into the overlap and waits there, so
+    // the second tile takes over its id
+    std::vector<Detection> dets;
+    std::vector<float> path = {50.f, 50.f, 50.f};
+    for (float x = 60.f; x <= 110.f; x += 5.f)
+        path.push_back(x);
+    path.insert(path.end(), {110.f, 110.f, 110.f});
+    for (float x : path)
+    {
+        dets = {makeBox(x, 50.f)};
+        tracker.update(dets);
+    }
+    int id = dets[0].track_id;
+    ASSERT_GT(id, 0);
+
+    // It leaves the first tile's margin as a second object steps onto its last position:
+    // the first tile's track follows the newcomer while the second tile keeps the id
+    dets = {makeBox(121.f, 50.f), makeBox(105.f, 50.f)};
+    tracker.update(dets);
+    EXPECT_GT(dets[0].track_id, 0);
+    EXPECT_GT(dets[1].track_id, 0);
+    EXPECT_NE(dets[0].track_id, dets[1].track_id);
+}
+
+TEST_F(TiledTrackerTest, ParallelTilesNumberTracksInTileOrder)
+{
+    std::vector<int> ids[2];
+    for (size_t threads : {1u, 4u})
+    {
+        BaseTrack::count = 0;
+        config.num_threads = threads;
+        auto tracker = makeTracker();
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            std::vector<Detection> dets;
+            for (int k = 0; k < 8; ++k)
+                dets.push_back(makeDet(45.f + 200.f * k, 45.f + 10.f * frame, 10.f, 10.f));
+            tracker.update(dets);
+            for (const auto &det : dets)
+                ids[threads > 1].push_back(det.track_id);
+        }
+    }
+    EXPECT_EQ(ids[0], ids[1]);
+}
+
+TEST_F(TiledTrackerTest, EmptyTilesAreDropped)
+{
+    auto tracker = makeTracker();
+    std::vector<Detection> dets = {makeDet(45.f, 45.f, 10.f, 10.f)};
+    tracker.update(dets);
+    EXPECT_EQ(tracker.getTileCount(), 1u);
+
+    std::vector<Detection> empty;
+    for (size_t i = 0; i <= sort_config.max_time_lost + 1; ++i)
+        tracker.update(empty);
+    EXPECT_EQ(tracker.getTileCount(), 0u);
+}
+
+TEST_F(TiledTrackerTest, MemoryReportSumsTiles)
+{
+    auto tracker = makeTracker();
+    std::vector<Detection> dets = {makeDet(45.f, 45.f, 10.f, 10.f), makeDet(245.f, 45.f, 10.f, 10.f)};
+    tracker.update(dets);
+    ASSERT_EQ(tracker.getTileCount(), 2u);
+
+    auto report = tracker.getMemoryReport();
+    EXPECT_EQ(report.num_tracks, 2u);
+    EXPECT_GT(report.filters, 0u);
+    EXPECT_GT(report.scratch, 0u);
+    EXPECT_TRUE(tracker.getTracks().empty());
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <parallel/thread_pool.hpp>
+#include <trace/trace.hpp>
+#include <tracking/sort.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef MOT_NO_PROFILING
+#define SKIP_WITHOUT_PROFILING() GTEST_SKIP() << "built with MOT_NO_PROFILING"
+#else
+#define SKIP_WITHOUT_PROFILING()
+#endif
+
+class TraceTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        SKIP_WITHOUT_PROFILING();
+        trace::stop();
+        trace::clear();
+    }
+
+    void TearDown() override
+    {
+        trace::stop();
+        trace::clear();
+    }
+
+    static std::string dump()
+    {
+        auto path = std::filesystem::path(testing::TempDir()) / "TraceTest.json";
+        trace::write(path);
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        std::filesystem::remove(path);
+        return content.str();
+    }
+
+    static size_t occurrences(const std::string &text, const std::string &pattern)
+    {
+        size_t count = 0;
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+            count++;
+        return count;
+    }
+};
+
+TEST_F(TraceTest, RecordsOnlyWhileStarted)
+{
+    {
+        trace::Scope scope("before");
+    }
+    trace::start();
+    {
+        trace::Scope outer("outer", "test");
+        trace::Scope inner("inner", "test");
+    }
+    trace::stop();
+    {
+        trace::Scope scope("after");
+    }
+
+    EXPECT_EQ(trace::size(), 2u);
+    auto json = dump();
+    EXPECT_EQ(json.find("\"before\""), std::string::npos);
+    EXPECT_EQ(json.find("\"after\""), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"outer\",\"cat\":\"test\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+}
+
+TEST_F(TraceTest, OneTrackPerThread)
+{
+    trace::start();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([t]()
+                             {
+            trace::setThreadName("worker " + std::to_string(t));
+            for (int i = 0; i < 5000; ++i)
+                trace::Scope scope("work"); });
+    for (auto &thread : threads)
+        thread.join();
+    trace::stop();
+
+    // Buffers outlive their threads and span several chunks
+    EXPECT_EQ(trace::size(), 20000u);
+    auto json = dump();
+    EXPECT_EQ(occurrences(json, "\"thread_name\""), 4u);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"worker 3\"}"), std::string::npos);
+    EXPECT_EQ(occurrences(json, "\"name\":\"work\""), 20000u);
+}
+
+TEST_F(TraceTest, DropsOverTheLimit)
+{
+    trace::start(10);
+    for (int i = 0; i < 25; ++i)
+        trace::Scope scope("event");
+    trace::stop();
+
+    EXPECT_EQ(trace::size(), 10u);
+    EXPECT_EQ(trace::dropped(), 15u);
+
+    trace::clear();
+    EXPECT_EQ(trace::size(), 0u);
+    EXPECT_EQ(trace::dropped(), 0u);
+}
+
+TEST_F(TraceTest, TrackerAndPoolEvents)
+{
+    trace::start();
+    {
+        ThreadPool pool(2);
+        pool.submit([]() {}).get();
+
+        Sort tracker(SortConfig{});
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            std::vector<Detection> detections(1);
+            detections[0].bbox = cv::Rect2f(10.f, 10.f, 40.f, 80.f);
+            detections[0].confidence = 0.9f;
+            tracker.update(detections);
+        }
+    }
+    trace::stop();
+
+    auto json = dump();
+    EXPECT_EQ(occurrences(json, "\"name\":\"Sort::update\""), 3u);
+    EXPECT_EQ(occurrences(json, "\"name\":\"predict\",\"cat\":\"tracker\""), 3u);
+    EXPECT_EQ(occurrences(json, "\"name\":\"solve\""), 2u);
+    EXPECT_EQ(occurrences(json, "\"name\":\"task\",\"cat\":\"pool\""), 1u);
+    EXPECT_NE(json.find("pool worker"), std::string::npos);
+}